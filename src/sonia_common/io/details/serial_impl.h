@@ -73,7 +73,7 @@ class Serial::SerialImpl {
 
   size_t Available();
 
-  bool WaitReadable(uint32_t timeout);
+  bool WaitReadable(uint32_t timeout, int interrupt_fd = -1);
 
   void WaitByteTimes(size_t count);
 
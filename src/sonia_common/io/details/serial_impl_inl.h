@@ -46,6 +46,7 @@
 #include <sysexits.h>
 #include <termios.h>
 #include <unistd.h>
+#include <algorithm>
 #include <sstream>
 
 #if defined(__linux__)
@@ -62,6 +63,7 @@
 #endif
 
 #include <sonia_common/sys/timer.h>
+#include <sonia_common/sys/trace_scope.h>
 
 #ifndef TIOCINQ
 #ifdef FIONREAD
@@ -555,13 +557,20 @@ ATLAS_INLINE size_t Serial::SerialImpl::Available() {
 
 //------------------------------------------------------------------------------
 //
-ATLAS_INLINE bool Serial::SerialImpl::WaitReadable(uint32_t timeout) {
-  // Setup a select call to block for serial data or a timeout
+ATLAS_INLINE bool Serial::SerialImpl::WaitReadable(uint32_t timeout,
+                                                   int interrupt_fd) {
+  // Setup a select call to block for serial data, an interruption or a
+  // timeout
   fd_set readfds;
   FD_ZERO(&readfds);
   FD_SET(fd_, &readfds);
+  int max_fd = fd_;
+  if (interrupt_fd != -1) {
+    FD_SET(interrupt_fd, &readfds);
+    max_fd = std::max(max_fd, interrupt_fd);
+  }
   timespec timeout_ts(MilliTimer::TimeSpecFromMs(timeout));
-  int r = pselect(fd_ + 1, &readfds, NULL, NULL, &timeout_ts, NULL);
+  int r = pselect(max_fd + 1, &readfds, NULL, NULL, &timeout_ts, NULL);
 
   if (r < 0) {
     // Select was interrupted
@@ -575,6 +584,10 @@ ATLAS_INLINE bool Serial::SerialImpl::WaitReadable(uint32_t timeout) {
   if (r == 0) {
     return false;
   }
+  // Woken up by the interrupt_fd
+  if (interrupt_fd != -1 && FD_ISSET(interrupt_fd, &readfds)) {
+    return false;
+  }
   // This shouldn't happen, if r > 0 our fd has to be in the list!
   if (!FD_ISSET(fd_, &readfds)) {
     ATLAS_THROW(IOException,
@@ -595,6 +608,7 @@ ATLAS_INLINE void Serial::SerialImpl::WaitByteTimes(size_t count) {
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
+  SONIA_TRACE_SCOPE("serial.read");
   // If the port is not open, throw
   if (!is_open_) {
     throw PortNotOpenedException("Serial::read");
@@ -675,6 +689,7 @@ ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
 //
 ATLAS_INLINE size_t Serial::SerialImpl::Write(const uint8_t *data,
                                               size_t length) {
+  SONIA_TRACE_SCOPE("serial.write");
   if (is_open_ == false) {
     throw PortNotOpenedException("Serial::write");
   }
@@ -37,7 +37,7 @@
 
 namespace sonia_common {
 
-class ImageSequenceCapture : public Subject<cv::Mat> {
+class ImageSequenceCapture : public Subject<const cv::Mat &> {
  public:
   //==========================================================================
   // T Y P E D E F   A N D   E N U M
@@ -256,6 +256,12 @@ class Serial {
    * (due to timeout or select interruption). */
   bool WaitReadable();
 
+  /** Same as WaitReadable(), but also returns false as soon as the
+   * interrupt_fd becomes readable, e.g. Runnable::GetStopEvent(), so a
+   * thread blocked on the port can be woken up. The interrupt_fd is not
+   * read, a value of -1 is ignored. */
+  bool WaitReadable(int interrupt_fd);
+
   /** Block for a period of time corresponding to the transmission time of
    * count characters at present serial settings. This may be used in con-
    * junction with waitReadable to read larger blocks of data from the
@@ -118,6 +118,13 @@ ATLAS_INLINE bool Serial::WaitReadable() {
   return pimpl_->WaitReadable(timeout.read_timeout_constant);
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::WaitReadable(int interrupt_fd) {
+  Timeout timeout(pimpl_->GetTimeout());
+  return pimpl_->WaitReadable(timeout.read_timeout_constant, interrupt_fd);
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE void Serial::WaitByteTimes(size_t count) {
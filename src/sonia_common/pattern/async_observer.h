@@ -0,0 +1,220 @@
+/**
+ * \file	async_observer.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_ASYNC_OBSERVER_H_
+#define SONIA_COMMON_PATTERN_ASYNC_OBSERVER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/observer.h>
+#include <sonia_common/pattern/thread_pool.h>
+
+namespace sonia_common {
+
+/**
+ * An observer that handles the notifications on a ThreadPool instead of on
+ * the thread calling Subject::Notify().
+ *
+ * The arguments of every notification are copied and queued, then the
+ * handler is called with them on a worker. The notifications are handled
+ * one at a time and in order, like on a strand, so the handler does not need
+ * to be thread safe. A slow handler thus only delays its own notifications,
+ * not the producer nor the other observers.
+ *
+ * The number of queued notifications is bounded, see OverflowPolicy. Since
+ * the arguments are copied, pass the heavy payloads through a SharedSubject,
+ * or by types that share their data on copy like cv::Mat.
+ *
+ * Declare the AsyncObserver after the state its handler uses: its
+ * destructor detaches it and waits for the queued notifications to be
+ * handled.
+ *
+ * Sample usage:
+ *
+ * class Recorder {
+ *  public:
+ *   Recorder(ImageSequenceCapture &capture, ThreadPool &pool)
+ *       : writer_(), observer_(pool, [this](const cv::Mat &image) {
+ *           writer_.Write(image);
+ *         }) {
+ *     observer_.Observe(capture);
+ *   }
+ *  private:
+ *   VideoWriter writer_;
+ *   AsyncObserver<const cv::Mat &> observer_;
+ * };
+ */
+template <typename... Args_>
+class AsyncObserver : public Observer<Args_...> {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<AsyncObserver<Args_...>>;
+
+  using Handler = std::function<void(Args_...)>;
+
+  /**
+   * What to do with a notification when max_pending ones are already queued.
+   */
+  enum class OverflowPolicy {
+    /**
+     * Make Notify() wait for room in the queue. A notifying thread that is a
+     * worker of the pool runs pending tasks in the meantime.
+     */
+    kBlock,
+
+    /**
+     * Drop the oldest queued notification.
+     */
+    kDropOldest,
+
+    /**
+     * Drop the new notification.
+     */
+    kDropNewest
+  };
+
+  struct Options {
+    Options() ATLAS_NOEXCEPT;
+
+    /**
+     * The maximum number of notifications waiting to be handled.
+     */
+    size_t max_pending;
+
+    OverflowPolicy overflow;
+  };
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Handle the notifications on the given pool, which must outlive this
+   * observer.
+   */
+  AsyncObserver(ThreadPool &pool, Handler handler,
+                const Options &options = Options());
+
+  /**
+   * Handle the notifications on a thread owned by this observer.
+   */
+  explicit AsyncObserver(Handler handler, const Options &options = Options());
+
+  ~AsyncObserver() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * Wait until all the queued notifications have been handled.
+   */
+  void Flush();
+
+  /**
+   * \return The number of notifications waiting to be handled.
+   */
+  size_t PendingCount() const;
+
+  uint64_t HandledCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of notifications dropped by the overflow policy.
+   */
+  uint64_t DroppedCount() const ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void OnSubjectNotify(Subject<Args_...> &subject, Args_... args) override;
+
+ private:
+  //==========================================================================
+  // P R I V A T E   T Y P E S
+
+  using Arguments = std::tuple<typename std::decay<Args_>::type...>;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Enqueue the task that handles the queued notifications, if it is not
+   * already. The mutex_ must be held.
+   */
+  void Schedule();
+
+  /**
+   * Wait for a change of the queue, with the mutex_ held by the lock.
+   */
+  void WaitOrHelp(std::unique_lock<std::mutex> &lock);
+
+  /**
+   * Handle the queued notifications, then reschedule itself if there are
+   * still some after a batch, to let the other tasks of the pool run.
+   */
+  void Drain();
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::unique_ptr<ThreadPool> own_pool_;
+
+  ThreadPool *pool_;
+
+  Handler handler_;
+
+  Options options_;
+
+  std::deque<Arguments> pending_;
+
+  /**
+   * Set while a Drain() task is queued or running.
+   */
+  bool scheduled_;
+
+  std::atomic<uint64_t> handled_count_;
+
+  std::atomic<uint64_t> dropped_count_;
+
+  mutable std::mutex mutex_;
+
+  std::condition_variable condition_;
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/async_observer_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_ASYNC_OBSERVER_H_
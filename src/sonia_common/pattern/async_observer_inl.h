@@ -0,0 +1,224 @@
+/**
+ * \file	async_observer_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_ASYNC_OBSERVER_H_
+#error This file may only be included from async_observer.h
+#endif
+
+#include <chrono>
+#include <utility>
+
+#include <sonia_common/pattern/details/apply.h>
+
+namespace sonia_common {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE AsyncObserver<Args_...>::Options::Options() ATLAS_NOEXCEPT
+    : max_pending(16),
+      overflow(OverflowPolicy::kBlock) {}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE AsyncObserver<Args_...>::AsyncObserver(ThreadPool &pool,
+                                                    Handler handler,
+                                                    const Options &options)
+    : Observer<Args_...>(),
+      own_pool_(),
+      pool_(&pool),
+      handler_(std::move(handler)),
+      options_(options),
+      pending_(),
+      scheduled_(false),
+      handled_count_(0),
+      dropped_count_(0),
+      mutex_(),
+      condition_() {
+  if (options_.max_pending == 0) {
+    options_.max_pending = 1;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE AsyncObserver<Args_...>::AsyncObserver(Handler handler,
+                                                    const Options &options)
+    : Observer<Args_...>(),
+      own_pool_(new ThreadPool(1)),
+      pool_(own_pool_.get()),
+      handler_(std::move(handler)),
+      options_(options),
+      pending_(),
+      scheduled_(false),
+      handled_count_(0),
+      dropped_count_(0),
+      mutex_(),
+      condition_() {
+  if (options_.max_pending == 0) {
+    options_.max_pending = 1;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE AsyncObserver<Args_...>::~AsyncObserver() ATLAS_NOEXCEPT {
+  this->DetachFromAllSubject();
+  // The queued Drain() task refers to this observer, let it finish.
+  Flush();
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void AsyncObserver<Args_...>::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (scheduled_) {
+    WaitOrHelp(lock);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE size_t AsyncObserver<Args_...>::PendingCount() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return pending_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE uint64_t AsyncObserver<Args_...>::HandledCount() const
+    ATLAS_NOEXCEPT {
+  return handled_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE uint64_t AsyncObserver<Args_...>::DroppedCount() const
+    ATLAS_NOEXCEPT {
+  return dropped_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void AsyncObserver<Args_...>::OnSubjectNotify(
+    Subject<Args_...> &, Args_... args) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (pending_.size() >= options_.max_pending) {
+    if (options_.overflow == OverflowPolicy::kDropNewest) {
+      ++dropped_count_;
+      return;
+    }
+    if (options_.overflow == OverflowPolicy::kDropOldest) {
+      pending_.pop_front();
+      ++dropped_count_;
+      break;
+    }
+    WaitOrHelp(lock);
+  }
+
+  pending_.emplace_back(args...);
+  Schedule();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void AsyncObserver<Args_...>::Schedule() {
+  if (!scheduled_) {
+    scheduled_ = true;
+    pool_->EnqueueDetached([this] { Drain(); });
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void AsyncObserver<Args_...>::WaitOrHelp(
+    std::unique_lock<std::mutex> &lock) {
+  // The Drain() task may be queued behind the task that is waiting on a
+  // worker, so run pending tasks rather than just blocking it. Any other
+  // thread just waits: a task it would pick could block it indefinitely.
+  if (pool_->IsWorkerThread()) {
+    lock.unlock();
+    bool has_run = pool_->RunPendingTask();
+    lock.lock();
+    if (has_run) {
+      return;
+    }
+  }
+  condition_.wait_for(lock, std::chrono::milliseconds(1));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void AsyncObserver<Args_...>::Drain() {
+  for (size_t i = 0; i < options_.max_pending; ++i) {
+    Arguments arguments;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (pending_.empty()) {
+        scheduled_ = false;
+        condition_.notify_all();
+        return;
+      }
+      arguments = std::move(pending_.front());
+      pending_.pop_front();
+      condition_.notify_all();
+    }
+
+    try {
+      details::Apply(handler_, arguments);
+    } catch (...) {
+      // Like the detached tasks of the pool, the handler must report its
+      // errors itself.
+    }
+    ++handled_count_;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  scheduled_ = false;
+  if (pending_.empty()) {
+    condition_.notify_all();
+  } else {
+    Schedule();
+  }
+}
+
+}  // namespace sonia_common
@@ -0,0 +1,295 @@
+/**
+ * \file	broadcast_ring.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_BROADCAST_RING_H_
+#define SONIA_COMMON_PATTERN_BROADCAST_RING_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <sonia_common/macros.h>
+
+namespace sonia_common {
+
+/**
+ * A single producer, multi consumer broadcast ring, in the style of the
+ * LMAX Disruptor.
+ *
+ * The producer writes each value once in a preallocated ring and publishes
+ * it by moving its sequence forward. Every consumer reads all the values
+ * through its own cursor: there is no lock, no allocation and no virtual
+ * call on the way, and a consumer that finds many values ready handles them
+ * in a batch before publishing its cursor once.
+ *
+ * The producer never overwrites a value that a consumer has not read: when
+ * the ring is full, it waits for the slowest consumer. Size the ring for the
+ * bursts the consumers must absorb.
+ *
+ * This is meant for streams in the kHz range, such as an IMU or hydrophone
+ * pings, where Subject::Notify() and its virtual call per observer and per
+ * sample is too expensive.
+ *
+ * Sample usage:
+ *
+ * BroadcastRing<ImuSample> ring(1024);
+ * BroadcastRing<ImuSample>::Consumer consumer(ring);
+ * std::thread filter([&] {
+ *   while (consumer.Wait([&](const ImuSample &sample) {
+ *     ekf.Update(sample);
+ *   })) {}
+ * });
+ * ring.Publish(imu.Read());
+ *
+ * \template Tp_ The type of the values, which must be default constructible
+ *          and copy or move assignable.
+ */
+template <class Tp_>
+class BroadcastRing {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<BroadcastRing<Tp_>>;
+
+  /**
+   * How the consumers wait for a value, and the producer for room in the
+   * ring.
+   */
+  enum class WaitStrategy {
+    /**
+     * Spin on the sequence. The lowest latency, but it burns a core per
+     * waiting thread: use it only on dedicated cores.
+     */
+    kBusySpin,
+
+    /**
+     * Yield the processor between the checks of the sequence.
+     */
+    kYield,
+
+    /**
+     * Spin for a little while, then sleep on a condition variable.
+     */
+    kBlock
+  };
+
+  /**
+   * A reader of the ring, with its own cursor.
+   *
+   * A consumer only sees the values published after its construction. It
+   * must be used by a single thread at a time and destroyed before the ring.
+   */
+  class Consumer {
+   public:
+    //==========================================================================
+    // P U B L I C   C / D T O R S
+
+    explicit Consumer(BroadcastRing<Tp_> &ring);
+
+    ~Consumer() ATLAS_NOEXCEPT;
+
+    Consumer(const Consumer &) = delete;
+
+    Consumer &operator=(const Consumer &) = delete;
+
+    //==========================================================================
+    // P U B L I C  M E T H O D S
+
+    /**
+     * Call the handler with each of the values ready to be read, without
+     * waiting.
+     *
+     * \param handler Called with a const reference to each value.
+     * \param max_count The maximum number of values to handle.
+     * \return The number of values handled.
+     */
+    template <class Fp_>
+    size_t Poll(Fp_ &&handler,
+                size_t max_count = std::numeric_limits<size_t>::max());
+
+    /**
+     * Wait for at least one value with the strategy of the ring, then handle
+     * all the ready ones like Poll().
+     *
+     * \return false if the ring is closed and every value has been read.
+     */
+    template <class Fp_>
+    bool Wait(Fp_ &&handler,
+              size_t max_count = std::numeric_limits<size_t>::max());
+
+    /**
+     * \return The sequence of the next value to read.
+     */
+    uint64_t Sequence() const ATLAS_NOEXCEPT;
+
+    /**
+     * \return The number of published values not read yet.
+     */
+    size_t Lag() const ATLAS_NOEXCEPT;
+
+   private:
+    friend class BroadcastRing<Tp_>;
+
+    BroadcastRing<Tp_> &ring_;
+
+    // The cursor is written by this consumer and read by the producer, keep
+    // it away from the other consumers.
+    char padding_0_[64];
+
+    std::atomic<uint64_t> cursor_;
+
+    char padding_1_[64];
+  };
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param capacity The number of values in the ring, rounded up to a power
+   *        of two.
+   */
+  explicit BroadcastRing(size_t capacity,
+                         WaitStrategy strategy = WaitStrategy::kBlock);
+
+  BroadcastRing(const BroadcastRing &) = delete;
+
+  BroadcastRing &operator=(const BroadcastRing &) = delete;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * Publish a copy of the value. Must only be called by the producer thread.
+   *
+   * Wait with the strategy of the ring if the slowest consumer is a whole
+   * ring behind.
+   */
+  void Publish(const Tp_ &value);
+
+  void Publish(Tp_ &&value);
+
+  /**
+   * Publish a value written in place by f, which is called with a reference
+   * to the slot of the ring. The slot holds an old value, f must overwrite
+   * all of it.
+   */
+  template <class Fp_>
+  void PublishWith(Fp_ &&f);
+
+  /**
+   * Wake up the consumers and make their Wait() return false once they have
+   * read every value.
+   */
+  void Close();
+
+  bool IsClosed() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The sequence of the next value to publish, which is also the
+   *         number of values published so far.
+   */
+  uint64_t Sequence() const ATLAS_NOEXCEPT;
+
+  size_t Capacity() const ATLAS_NOEXCEPT;
+
+  WaitStrategy GetWaitStrategy() const ATLAS_NOEXCEPT;
+
+  size_t ConsumerCount() const;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void AddConsumer(Consumer *consumer);
+
+  void RemoveConsumer(Consumer *consumer);
+
+  /**
+   * Wait until the slot of the sequence has been read by every consumer.
+   */
+  void WaitForRoom(uint64_t sequence);
+
+  /**
+   * \return The sequence of the slowest consumer, or the given one if there
+   *         is no consumer.
+   */
+  uint64_t MinimumCursor(uint64_t sequence) const;
+
+  /**
+   * Wait with the strategy of the ring until the predicate is true.
+   */
+  template <class Predicate_>
+  void WaitUntil(Predicate_ predicate);
+
+  /**
+   * Wake up the threads blocked in WaitUntil().
+   */
+  void Signal();
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::unique_ptr<Tp_[]> slots_;
+
+  size_t mask_;
+
+  WaitStrategy strategy_;
+
+  std::vector<Consumer *> consumers_;
+
+  mutable std::mutex consumers_mutex_;
+
+  /**
+   * Owned by the producer: a lower bound of the cursors of the consumers,
+   * so the list of consumers is only read once per lap of the ring.
+   */
+  uint64_t gating_sequence_;
+
+  char padding_0_[64];
+
+  std::atomic<uint64_t> sequence_;
+
+  char padding_1_[64];
+
+  std::atomic<bool> closed_;
+
+  std::atomic<int> waiters_;
+
+  std::mutex mutex_;
+
+  std::condition_variable condition_;
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/broadcast_ring_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_BROADCAST_RING_H_
@@ -0,0 +1,321 @@
+/**
+ * \file	broadcast_ring_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_BROADCAST_RING_H_
+#error This file may only be included from broadcast_ring.h
+#endif
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include <sonia_common/pattern/details/mpmc_queue.h>
+
+namespace sonia_common {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE BroadcastRing<Tp_>::Consumer::Consumer(BroadcastRing<Tp_> &ring)
+    : ring_(ring), cursor_(0) {
+  ring_.AddConsumer(this);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE BroadcastRing<Tp_>::Consumer::~Consumer() ATLAS_NOEXCEPT {
+  ring_.RemoveConsumer(this);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE BroadcastRing<Tp_>::BroadcastRing(size_t capacity,
+                                               WaitStrategy strategy)
+    : slots_(),
+      mask_(0),
+      strategy_(strategy),
+      consumers_(),
+      consumers_mutex_(),
+      gating_sequence_(0),
+      sequence_(0),
+      closed_(false),
+      waiters_(0),
+      mutex_(),
+      condition_() {
+  size_t rounded = 2;
+  while (rounded < capacity) {
+    rounded <<= 1;
+  }
+  slots_.reset(new Tp_[rounded]);
+  mask_ = rounded - 1;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class Fp_>
+ATLAS_INLINE size_t BroadcastRing<Tp_>::Consumer::Poll(Fp_ &&handler,
+                                                       size_t max_count) {
+  const uint64_t cursor = cursor_.load(std::memory_order_relaxed);
+  const uint64_t available =
+      ring_.sequence_.load(std::memory_order_acquire) - cursor;
+  const size_t count =
+      static_cast<size_t>(std::min<uint64_t>(available, max_count));
+  if (count == 0) {
+    return 0;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    handler(static_cast<const Tp_ &>(ring_.slots_[(cursor + i) & ring_.mask_]));
+  }
+  cursor_.store(cursor + count, std::memory_order_release);
+
+  if (ring_.strategy_ == WaitStrategy::kBlock) {
+    // The producer may be waiting for this consumer to make room.
+    ring_.Signal();
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class Fp_>
+ATLAS_INLINE bool BroadcastRing<Tp_>::Consumer::Wait(Fp_ &&handler,
+                                                     size_t max_count) {
+  const uint64_t cursor = cursor_.load(std::memory_order_relaxed);
+  ring_.WaitUntil([this, cursor] {
+    return ring_.sequence_.load(std::memory_order_acquire) != cursor ||
+           ring_.IsClosed();
+  });
+  // Once closed, the values published before are still read first.
+  return Poll(std::forward<Fp_>(handler), max_count) != 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE uint64_t BroadcastRing<Tp_>::Consumer::Sequence() const
+    ATLAS_NOEXCEPT {
+  return cursor_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t BroadcastRing<Tp_>::Consumer::Lag() const ATLAS_NOEXCEPT {
+  return static_cast<size_t>(ring_.Sequence() - Sequence());
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void BroadcastRing<Tp_>::Publish(const Tp_ &value) {
+  PublishWith([&value](Tp_ &slot) { slot = value; });
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void BroadcastRing<Tp_>::Publish(Tp_ &&value) {
+  PublishWith([&value](Tp_ &slot) { slot = std::move(value); });
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class Fp_>
+ATLAS_INLINE void BroadcastRing<Tp_>::PublishWith(Fp_ &&f) {
+  const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  if (sequence - gating_sequence_ > mask_) {
+    WaitForRoom(sequence);
+  }
+
+  f(slots_[sequence & mask_]);
+  sequence_.store(sequence + 1, std::memory_order_release);
+
+  if (strategy_ == WaitStrategy::kBlock) {
+    Signal();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void BroadcastRing<Tp_>::Close() {
+  closed_ = true;
+  std::lock_guard<std::mutex> guard(mutex_);
+  condition_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool BroadcastRing<Tp_>::IsClosed() const ATLAS_NOEXCEPT {
+  return closed_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE uint64_t BroadcastRing<Tp_>::Sequence() const ATLAS_NOEXCEPT {
+  return sequence_.load(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t BroadcastRing<Tp_>::Capacity() const ATLAS_NOEXCEPT {
+  return mask_ + 1;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE typename BroadcastRing<Tp_>::WaitStrategy
+BroadcastRing<Tp_>::GetWaitStrategy() const ATLAS_NOEXCEPT {
+  return strategy_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t BroadcastRing<Tp_>::ConsumerCount() const {
+  std::lock_guard<std::mutex> guard(consumers_mutex_);
+  return consumers_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void BroadcastRing<Tp_>::AddConsumer(Consumer *consumer) {
+  std::lock_guard<std::mutex> guard(consumers_mutex_);
+  // The new cursor is never behind the gating sequence of the producer, it
+  // may start reading right away.
+  consumer->cursor_.store(sequence_.load(std::memory_order_acquire),
+                          std::memory_order_relaxed);
+  consumers_.push_back(consumer);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void BroadcastRing<Tp_>::RemoveConsumer(Consumer *consumer) {
+  {
+    std::lock_guard<std::mutex> guard(consumers_mutex_);
+    consumers_.erase(
+        std::remove(consumers_.begin(), consumers_.end(), consumer),
+        consumers_.end());
+  }
+  // The producer may be waiting for this consumer.
+  Signal();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void BroadcastRing<Tp_>::WaitForRoom(uint64_t sequence) {
+  gating_sequence_ = MinimumCursor(sequence);
+  if (sequence - gating_sequence_ <= mask_) {
+    return;
+  }
+  WaitUntil([this, sequence] {
+    gating_sequence_ = MinimumCursor(sequence);
+    return sequence - gating_sequence_ <= mask_;
+  });
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE uint64_t
+BroadcastRing<Tp_>::MinimumCursor(uint64_t sequence) const {
+  std::lock_guard<std::mutex> guard(consumers_mutex_);
+  uint64_t minimum = sequence;
+  for (const Consumer *consumer : consumers_) {
+    minimum = std::min(minimum,
+                       consumer->cursor_.load(std::memory_order_acquire));
+  }
+  return minimum;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class Predicate_>
+ATLAS_INLINE void BroadcastRing<Tp_>::WaitUntil(Predicate_ predicate) {
+  switch (strategy_) {
+    case WaitStrategy::kBusySpin:
+      while (!predicate()) {
+        details::CpuRelax();
+      }
+      return;
+
+    case WaitStrategy::kYield:
+      while (!predicate()) {
+        std::this_thread::yield();
+      }
+      return;
+
+    case WaitStrategy::kBlock:
+      for (int i = 0; i < 100; ++i) {
+        if (predicate()) {
+          return;
+        }
+        details::CpuRelax();
+      }
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // Registering before checking the predicate again pairs with the
+        // fence in Signal(): either we see the change, or Signal() sees us.
+        ++waiters_;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        condition_.wait(lock, predicate);
+        --waiters_;
+      }
+      return;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void BroadcastRing<Tp_>::Signal() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiters_.load(std::memory_order_relaxed) != 0) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    condition_.notify_all();
+  }
+}
+
+}  // namespace sonia_common
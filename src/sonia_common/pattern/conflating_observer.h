@@ -0,0 +1,203 @@
+/**
+ * \file	conflating_observer.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_CONFLATING_OBSERVER_H_
+#define SONIA_COMMON_PATTERN_CONFLATING_OBSERVER_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/observer.h>
+
+namespace sonia_common {
+
+/**
+ * An observer that only handles the latest notification, on a thread of its
+ * own.
+ *
+ * A notification overwrites the previous one if the handler has not taken it
+ * yet: a slow handler skips the intermediate values instead of building up a
+ * backlog, and the producer never waits for it. This is what a consumer of a
+ * high rate sensor, such as an IMU or a camera, usually wants.
+ *
+ * The latest arguments are stored in a triple buffer. The handler takes them
+ * without any lock and gets a reference to the stored copy, the producer
+ * only copies them and swaps an index. Concurrent producers serialize
+ * between themselves on a spin flag.
+ *
+ * The decayed types of the arguments must be default constructible and
+ * copy assignable.
+ *
+ * Sample usage:
+ *
+ * ConflatingObserver<const cv::Mat &> viewer([](const cv::Mat &image) {
+ *   cv::imshow("camera", image);
+ *   cv::waitKey(1);
+ * });
+ * viewer.Observe(capture);
+ */
+template <typename... Args_>
+class ConflatingObserver : public Observer<Args_...> {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<ConflatingObserver<Args_...>>;
+
+  using Handler = std::function<void(Args_...)>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit ConflatingObserver(Handler handler);
+
+  /**
+   * Detach the observer, then handle the latest notification if it is still
+   * pending before stopping the thread.
+   */
+  ~ConflatingObserver() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * Wait until the latest notification has been handled.
+   */
+  void Flush();
+
+  uint64_t ReceivedCount() const ATLAS_NOEXCEPT;
+
+  uint64_t HandledCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of notifications overwritten by a newer one before
+   *         the handler took them.
+   */
+  uint64_t DroppedCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of handler calls that stood for more than one
+   *         notification.
+   */
+  uint64_t CoalescedCount() const ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void OnSubjectNotify(Subject<Args_...> &subject, Args_... args) override;
+
+ private:
+  //==========================================================================
+  // P R I V A T E   T Y P E S
+
+  using Arguments = std::tuple<typename std::decay<Args_>::type...>;
+
+  /**
+   * The latest_ index has this bit set when the buffer has not been taken
+   * by the handler yet.
+   */
+  static constexpr uint8_t kFresh = 4;
+
+  static constexpr uint8_t kIndexMask = 3;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  bool HasFresh() const ATLAS_NOEXCEPT;
+
+  /**
+   * Swap the front buffer with the latest one.
+   *
+   * \return false if there is no notification to handle.
+   */
+  bool TakeLatest() ATLAS_NOEXCEPT;
+
+  void Run();
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  Handler handler_;
+
+  std::array<Arguments, 3> buffers_;
+
+  /**
+   * The number of the notification held by each buffer.
+   */
+  std::array<uint64_t, 3> sequences_;
+
+  /**
+   * The buffer the producers write into.
+   */
+  uint8_t back_;
+
+  /**
+   * The buffer the handler reads from.
+   */
+  uint8_t front_;
+
+  std::atomic<uint8_t> latest_;
+
+  std::atomic_flag writing_;
+
+  std::atomic<uint64_t> received_count_;
+
+  std::atomic<uint64_t> handled_count_;
+
+  std::atomic<uint64_t> dropped_count_;
+
+  std::atomic<uint64_t> coalesced_count_;
+
+  /**
+   * The handler thread is sleeping, the producers must wake it up.
+   */
+  std::atomic<bool> waiting_;
+
+  bool stop_;
+
+  std::mutex mutex_;
+
+  std::condition_variable condition_;
+
+  std::condition_variable idle_condition_;
+
+  std::thread thread_;
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/conflating_observer_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_CONFLATING_OBSERVER_H_
@@ -0,0 +1,198 @@
+/**
+ * \file	conflating_observer_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_CONFLATING_OBSERVER_H_
+#error This file may only be included from conflating_observer.h
+#endif
+
+#include <utility>
+
+#include <sonia_common/pattern/details/apply.h>
+
+namespace sonia_common {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE ConflatingObserver<Args_...>::ConflatingObserver(Handler handler)
+    : Observer<Args_...>(),
+      handler_(std::move(handler)),
+      buffers_(),
+      sequences_(),
+      back_(0),
+      front_(1),
+      latest_(2),
+      writing_(),
+      received_count_(0),
+      handled_count_(0),
+      dropped_count_(0),
+      coalesced_count_(0),
+      waiting_(false),
+      stop_(false),
+      mutex_(),
+      condition_(),
+      idle_condition_(),
+      thread_() {
+  writing_.clear();
+  sequences_.fill(0);
+  thread_ = std::thread(&ConflatingObserver<Args_...>::Run, this);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE ConflatingObserver<Args_...>::~ConflatingObserver()
+    ATLAS_NOEXCEPT {
+  this->DetachFromAllSubject();
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_one();
+  thread_.join();
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void ConflatingObserver<Args_...>::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_condition_.wait(lock, [this] { return waiting_ && !HasFresh(); });
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE uint64_t ConflatingObserver<Args_...>::ReceivedCount() const
+    ATLAS_NOEXCEPT {
+  return received_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE uint64_t ConflatingObserver<Args_...>::HandledCount() const
+    ATLAS_NOEXCEPT {
+  return handled_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE uint64_t ConflatingObserver<Args_...>::DroppedCount() const
+    ATLAS_NOEXCEPT {
+  return dropped_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE uint64_t ConflatingObserver<Args_...>::CoalescedCount() const
+    ATLAS_NOEXCEPT {
+  return coalesced_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void ConflatingObserver<Args_...>::OnSubjectNotify(
+    Subject<Args_...> &, Args_... args) {
+  while (writing_.test_and_set(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+  buffers_[back_] = Arguments(args...);
+  sequences_[back_] = ++received_count_;
+  const uint8_t published = static_cast<uint8_t>(back_ | kFresh);
+  back_ = latest_.exchange(published) & kIndexMask;
+  writing_.clear(std::memory_order_release);
+
+  // Pairs with the handler thread that sets waiting_ before checking for a
+  // fresh buffer: either it sees the buffer, or we see it waiting.
+  if (waiting_) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    condition_.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE bool ConflatingObserver<Args_...>::HasFresh() const
+    ATLAS_NOEXCEPT {
+  return (latest_ & kFresh) != 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE bool ConflatingObserver<Args_...>::TakeLatest() ATLAS_NOEXCEPT {
+  if (!HasFresh()) {
+    return false;
+  }
+  front_ = latest_.exchange(front_) & kIndexMask;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void ConflatingObserver<Args_...>::Run() {
+  uint64_t last_sequence = 0;
+  for (;;) {
+    if (TakeLatest()) {
+      const uint64_t sequence = sequences_[front_];
+      if (sequence - last_sequence > 1) {
+        dropped_count_ += sequence - last_sequence - 1;
+        ++coalesced_count_;
+      }
+      last_sequence = sequence;
+
+      try {
+        details::Apply(handler_, buffers_[front_]);
+      } catch (...) {
+        // The handler must report its errors itself, like a detached task.
+      }
+      ++handled_count_;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiting_ = true;
+    idle_condition_.notify_all();
+    condition_.wait(lock, [this] { return HasFresh() || stop_; });
+    waiting_ = false;
+    if (stop_ && !HasFresh()) {
+      return;
+    }
+  }
+}
+
+}  // namespace sonia_common
@@ -0,0 +1,72 @@
+/**
+ * \file	apply.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_DETAILS_APPLY_H_
+#define SONIA_COMMON_PATTERN_DETAILS_APPLY_H_
+
+#include <cstddef>
+#include <tuple>
+
+#include <sonia_common/macros.h>
+
+namespace sonia_common {
+
+namespace details {
+
+/**
+ * The C++11 counterpart of std::index_sequence.
+ */
+template <size_t... Indexes_>
+struct IndexSequence {};
+
+template <size_t Size_, size_t... Indexes_>
+struct MakeIndexSequence
+    : MakeIndexSequence<Size_ - 1, Size_ - 1, Indexes_...> {};
+
+template <size_t... Indexes_>
+struct MakeIndexSequence<0, Indexes_...> {
+  using type = IndexSequence<Indexes_...>;
+};
+
+template <class Fp_, class Tuple_, size_t... Indexes_>
+ATLAS_ALWAYS_INLINE void Apply(Fp_ &f, Tuple_ &arguments,
+                               IndexSequence<Indexes_...>) {
+  f(std::get<Indexes_>(arguments)...);
+}
+
+/**
+ * Call f with the elements of the tuple, passed as lvalues. Used to replay
+ * the arguments of a notification stored for later.
+ */
+template <class Fp_, class... Tp_>
+ATLAS_ALWAYS_INLINE void Apply(Fp_ &f, std::tuple<Tp_...> &arguments) {
+  Apply(f, arguments, typename MakeIndexSequence<sizeof...(Tp_)>::type());
+}
+
+}  // namespace details
+
+}  // namespace sonia_common
+
+#endif  // SONIA_COMMON_PATTERN_DETAILS_APPLY_H_
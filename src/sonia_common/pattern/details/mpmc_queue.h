@@ -0,0 +1,205 @@
+/**
+ * \file	mpmc_queue.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_DETAILS_MPMC_QUEUE_H_
+#define SONIA_COMMON_PATTERN_DETAILS_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <sonia_common/macros.h>
+
+namespace sonia_common {
+
+namespace details {
+
+/**
+ * Tell the processor we are in a spin loop, which frees resources for the
+ * sibling hyper-thread and lowers the power used while spinning.
+ */
+ATLAS_ALWAYS_INLINE void CpuRelax() ATLAS_NOEXCEPT {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * A bounded multi-producer multi-consumer lock-free queue.
+ *
+ * This is the queue described by Dmitry Vyukov: every cell carries a sequence
+ * number telling whether it is ready to be written or read for the current
+ * lap of the ring. A producer or a consumer claims a cell with a single
+ * compare and swap on its position counter, so no thread ever waits for
+ * another one as long as the queue is neither full nor empty.
+ *
+ * The capacity is rounded up to a power of two.
+ */
+template <class Tp_>
+class MpmcQueue {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit MpmcQueue(size_t capacity);
+
+  MpmcQueue(const MpmcQueue &) = delete;
+
+  MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * Move the value in the queue.
+   *
+   * \return False if the queue is full, the value is then left untouched.
+   */
+  bool TryPush(Tp_ &&value);
+
+  /**
+   * Move the oldest value of the queue in the given argument.
+   *
+   * \return False if the queue is empty.
+   */
+  bool TryPop(Tp_ &value);
+
+  size_t Capacity() const ATLAS_NOEXCEPT;
+
+ private:
+  //==========================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    Tp_ value;
+  };
+
+  enum : size_t { kCacheLineSize = 64 };
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::unique_ptr<Cell[]> cells_;
+
+  size_t mask_;
+
+  // The producers and the consumers each hammer their own counter, keep them
+  // on different cache lines.
+  char padding_0_[kCacheLineSize];
+
+  std::atomic<size_t> enqueue_position_;
+
+  char padding_1_[kCacheLineSize];
+
+  std::atomic<size_t> dequeue_position_;
+
+  char padding_2_[kCacheLineSize];
+};
+
+//==============================================================================
+// I N L I N E   M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE MpmcQueue<Tp_>::MpmcQueue(size_t capacity)
+    : cells_(), mask_(0), enqueue_position_(0), dequeue_position_(0) {
+  size_t rounded = 2;
+  while (rounded < capacity) {
+    rounded <<= 1;
+  }
+  cells_.reset(new Cell[rounded]);
+  mask_ = rounded - 1;
+  for (size_t i = 0; i < rounded; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool MpmcQueue<Tp_>::TryPush(Tp_ &&value) {
+  size_t position = enqueue_position_.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell &cell = cells_[position & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    auto difference = static_cast<std::ptrdiff_t>(sequence) -
+                      static_cast<std::ptrdiff_t>(position);
+    if (difference == 0) {
+      if (enqueue_position_.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+        cell.value = std::move(value);
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      return false;
+    } else {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool MpmcQueue<Tp_>::TryPop(Tp_ &value) {
+  size_t position = dequeue_position_.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell &cell = cells_[position & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    auto difference = static_cast<std::ptrdiff_t>(sequence) -
+                      static_cast<std::ptrdiff_t>(position + 1);
+    if (difference == 0) {
+      if (dequeue_position_.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+        value = std::move(cell.value);
+        cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      return false;
+    } else {
+      position = dequeue_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE size_t MpmcQueue<Tp_>::Capacity() const ATLAS_NOEXCEPT {
+  return mask_ + 1;
+}
+
+}  // namespace details
+
+}  // namespace sonia_common
+
+#endif  // SONIA_COMMON_PATTERN_DETAILS_MPMC_QUEUE_H_
@@ -0,0 +1,166 @@
+/**
+ * \file	task_queue.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_DETAILS_TASK_QUEUE_H_
+#define SONIA_COMMON_PATTERN_DETAILS_TASK_QUEUE_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/task.h>
+
+namespace sonia_common {
+
+namespace details {
+
+/**
+ * A growable circular buffer of Task used as the queues of the ThreadPool.
+ *
+ * Tasks can be pushed at the back and popped from both ends. The buffer only
+ * grows, by powers of two, so once a queue has reached its working size,
+ * pushing and popping do not allocate anymore. std::deque, on the other hand,
+ * keeps releasing and allocating its chunks as the tasks flow through it.
+ *
+ * This class is not thread safe, the ThreadPool guards it with a mutex.
+ */
+class TaskQueue {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit TaskQueue(size_t capacity = 64);
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  bool Empty() const ATLAS_NOEXCEPT;
+
+  size_t Size() const ATLAS_NOEXCEPT;
+
+  size_t Capacity() const ATLAS_NOEXCEPT;
+
+  void PushBack(Task &&task);
+
+  /**
+   * Move the oldest task in the given argument. The queue must not be empty.
+   */
+  void PopFront(Task &task) ATLAS_NOEXCEPT;
+
+  /**
+   * Move the newest task in the given argument. The queue must not be empty.
+   */
+  void PopBack(Task &task) ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void Grow();
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::vector<Task> buffer_;
+
+  size_t head_;
+
+  size_t size_;
+};
+
+//==============================================================================
+// I N L I N E   M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TaskQueue::TaskQueue(size_t capacity)
+    : buffer_(), head_(0), size_(0) {
+  size_t rounded = 1;
+  while (rounded < capacity) {
+    rounded <<= 1;
+  }
+  buffer_.resize(rounded);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE bool TaskQueue::Empty() const ATLAS_NOEXCEPT {
+  return size_ == 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE size_t TaskQueue::Size() const ATLAS_NOEXCEPT {
+  return size_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE size_t TaskQueue::Capacity() const ATLAS_NOEXCEPT {
+  return buffer_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void TaskQueue::PushBack(Task &&task) {
+  if (size_ == buffer_.size()) {
+    Grow();
+  }
+  buffer_[(head_ + size_) & (buffer_.size() - 1)] = std::move(task);
+  ++size_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void TaskQueue::PopFront(Task &task) ATLAS_NOEXCEPT {
+  task = std::move(buffer_[head_]);
+  head_ = (head_ + 1) & (buffer_.size() - 1);
+  --size_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void TaskQueue::PopBack(Task &task) ATLAS_NOEXCEPT {
+  --size_;
+  task = std::move(buffer_[(head_ + size_) & (buffer_.size() - 1)]);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TaskQueue::Grow() {
+  std::vector<Task> buffer(buffer_.size() * 2);
+  for (size_t i = 0; i < size_; ++i) {
+    buffer[i] = std::move(buffer_[(head_ + i) & (buffer_.size() - 1)]);
+  }
+  buffer_.swap(buffer);
+  head_ = 0;
+}
+
+}  // namespace details
+
+}  // namespace sonia_common
+
+#endif  // SONIA_COMMON_PATTERN_DETAILS_TASK_QUEUE_H_
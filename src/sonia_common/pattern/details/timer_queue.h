@@ -0,0 +1,356 @@
+/**
+ * \file	timer_queue.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_DETAILS_TIMER_QUEUE_H_
+#define SONIA_COMMON_PATTERN_DETAILS_TIMER_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/task.h>
+
+namespace sonia_common {
+
+namespace details {
+
+/**
+ * A delayed or periodic task of a TimerQueue, shared with the handle given
+ * to the user and with the firings in flight.
+ */
+struct TimerEntry {
+  using Clock = std::chrono::steady_clock;
+
+  TimerEntry(std::function<void()> task, Clock::duration period);
+
+  /**
+   * Run the task for the firing planned at the given deadline, and record
+   * how late it started. This is called on a worker of the pool.
+   */
+  void Fire(Clock::time_point deadline) ATLAS_NOEXCEPT;
+
+  std::function<void()> task;
+
+  /**
+   * The period of the task, zero if it only runs once.
+   */
+  const Clock::duration period;
+
+  std::atomic<bool> cancelled;
+
+  /**
+   * Set while a firing is queued or running, so a periodic task never runs
+   * twice at once.
+   */
+  std::atomic<bool> running;
+
+  std::atomic<uint64_t> firings;
+
+  std::atomic<uint64_t> skipped;
+
+  std::atomic<int64_t> last_lateness;
+
+  std::atomic<int64_t> max_lateness;
+
+  std::atomic<int64_t> total_lateness;
+};
+
+/**
+ * A min heap of timers served by a single thread.
+ *
+ * The thread sleeps until the earliest deadline, then hands the task to the
+ * dispatch function -- the ThreadPool enqueues it on its workers -- and
+ * schedules the next firing of the periodic ones. The deadlines are absolute
+ * points of the steady clock, which is CLOCK_MONOTONIC on Linux, so a
+ * periodic task does not drift and is not affected by changes of the wall
+ * clock.
+ *
+ * A cancelled timer is only removed from the heap when its deadline comes.
+ */
+class TimerQueue {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Clock = std::chrono::steady_clock;
+
+  using Dispatch = std::function<void(Task &&)>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit TimerQueue(Dispatch dispatch);
+
+  ~TimerQueue() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  void Schedule(Clock::time_point deadline,
+                const std::shared_ptr<TimerEntry> &entry);
+
+  /**
+   * Stop the timer thread. The timers that did not fire yet are dropped.
+   */
+  void Stop() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of timers in the heap, cancelled ones included.
+   */
+  size_t Size() const;
+
+ private:
+  //==========================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Timer {
+    Clock::time_point deadline;
+    uint64_t sequence;
+    std::shared_ptr<TimerEntry> entry;
+  };
+
+  struct LaterDeadline {
+    bool operator()(const Timer &lhs, const Timer &rhs) const ATLAS_NOEXCEPT;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void Loop();
+
+  /**
+   * Dispatch the firing of the timer.
+   *
+   * \return The deadline of the next firing, Clock::time_point::max() if
+   *         there is none.
+   */
+  Clock::time_point DispatchTimer(const Timer &timer);
+
+  void Push(Clock::time_point deadline,
+            const std::shared_ptr<TimerEntry> &entry);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  Dispatch dispatch_;
+
+  std::vector<Timer> timers_;
+
+  uint64_t sequence_;
+
+  bool stopped_;
+
+  mutable std::mutex mutex_;
+
+  std::condition_variable condition_;
+
+  std::thread thread_;
+};
+
+//==============================================================================
+// I N L I N E   M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TimerEntry::TimerEntry(std::function<void()> task,
+                                    Clock::duration period)
+    : task(std::move(task)),
+      period(period),
+      cancelled(false),
+      running(false),
+      firings(0),
+      skipped(0),
+      last_lateness(0),
+      max_lateness(0),
+      total_lateness(0) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TimerEntry::Fire(Clock::time_point deadline) ATLAS_NOEXCEPT {
+  if (cancelled) {
+    running = false;
+    return;
+  }
+
+  auto lateness = (Clock::now() - deadline).count();
+  last_lateness = lateness;
+  total_lateness += lateness;
+  auto max = max_lateness.load();
+  while (lateness > max && !max_lateness.compare_exchange_weak(max, lateness)) {
+  }
+  ++firings;
+
+  try {
+    task();
+  } catch (...) {
+    // Like the detached tasks of the pool, errors must be reported through
+    // the captured state.
+  }
+  running = false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TimerQueue::TimerQueue(Dispatch dispatch)
+    : dispatch_(std::move(dispatch)),
+      timers_(),
+      sequence_(0),
+      stopped_(false),
+      mutex_(),
+      condition_(),
+      thread_([this] { Loop(); }) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TimerQueue::~TimerQueue() ATLAS_NOEXCEPT { Stop(); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TimerQueue::Schedule(
+    Clock::time_point deadline, const std::shared_ptr<TimerEntry> &entry) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    Push(deadline, entry);
+  }
+  condition_.notify_one();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TimerQueue::Stop() ATLAS_NOEXCEPT {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopped_ = true;
+    timers_.clear();
+  }
+  condition_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t TimerQueue::Size() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return timers_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE bool TimerQueue::LaterDeadline::operator()(
+    const Timer &lhs, const Timer &rhs) const ATLAS_NOEXCEPT {
+  if (lhs.deadline != rhs.deadline) {
+    return lhs.deadline > rhs.deadline;
+  }
+  return lhs.sequence > rhs.sequence;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TimerQueue::Loop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopped_) {
+    if (timers_.empty()) {
+      condition_.wait(lock);
+      continue;
+    }
+    if (Clock::now() < timers_.front().deadline) {
+      condition_.wait_until(lock, timers_.front().deadline);
+      continue;
+    }
+
+    std::pop_heap(timers_.begin(), timers_.end(), LaterDeadline());
+    Timer timer = std::move(timers_.back());
+    timers_.pop_back();
+    if (timer.entry->cancelled) {
+      continue;
+    }
+
+    lock.unlock();
+    auto next = DispatchTimer(timer);
+    lock.lock();
+    if (next != Clock::time_point::max() && !stopped_) {
+      Push(next, timer.entry);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TimerQueue::Clock::time_point TimerQueue::DispatchTimer(
+    const Timer &timer) {
+  auto &entry = timer.entry;
+  if (entry->running.exchange(true)) {
+    // The previous firing of this periodic task is still queued or running.
+    ++entry->skipped;
+  } else {
+    auto deadline = timer.deadline;
+    try {
+      dispatch_(Task([entry, deadline] { entry->Fire(deadline); }));
+    } catch (...) {
+      // The pool is stopping, there is nothing left to schedule.
+      entry->running = false;
+      return Clock::time_point::max();
+    }
+  }
+
+  if (entry->period <= Clock::duration::zero()) {
+    return Clock::time_point::max();
+  }
+
+  // Keep the deadlines on the grid of the period. If the thread has been
+  // delayed past the next firings, they are counted as skipped.
+  auto next = timer.deadline + entry->period;
+  auto now = Clock::now();
+  if (next <= now) {
+    auto missed = (now - timer.deadline) / entry->period;
+    entry->skipped += missed;
+    next = timer.deadline + (missed + 1) * entry->period;
+  }
+  return next;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TimerQueue::Push(Clock::time_point deadline,
+                                   const std::shared_ptr<TimerEntry> &entry) {
+  timers_.push_back(Timer{deadline, sequence_++, entry});
+  std::push_heap(timers_.begin(), timers_.end(), LaterDeadline());
+}
+
+}  // namespace details
+
+}  // namespace sonia_common
+
+#endif  // SONIA_COMMON_PATTERN_DETAILS_TIMER_QUEUE_H_
@@ -0,0 +1,231 @@
+/**
+ * \file	event_hub.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_EVENT_HUB_H_
+#define SONIA_COMMON_PATTERN_EVENT_HUB_H_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/observer.h>
+#include <sonia_common/pattern/subject.h>
+
+namespace sonia_common {
+
+/**
+ * A set of subjects keyed by topic, to publish events to the observers of
+ * one topic only.
+ *
+ * Each topic is a Subject, created when an observer first subscribes to it.
+ * Publishing an event only notifies the observers of its topic, so a
+ * subscriber interested in a single RS485 slave or detection class does not
+ * filter the others in its callback.
+ *
+ * The topics with an integral or enum key lower than the number of direct
+ * topics given to the constructor are found by indexing an array, the other
+ * ones through a hash map. In both cases Publish() never waits for a
+ * subscription in progress.
+ *
+ * A subscription can also have a predicate on the arguments, checked before
+ * notifying the observer.
+ *
+ * Sample usage:
+ *
+ * EventHub<uint8_t, const Rs485Message &> rs485_hub;
+ * rs485_hub.Subscribe(kDvlSlaveId, dvl_driver);
+ * rs485_hub.Subscribe(kPowerSlaveId, battery_monitor,
+ *                     [](const Rs485Message &message) {
+ *                       return message.command == kBatteryLevel;
+ *                     });
+ * rs485_hub.Publish(message.slave_id, message);
+ */
+template <typename Key_, typename... Args_>
+class EventHub {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<EventHub<Key_, Args_...>>;
+
+  using Topic = Subject<Args_...>;
+
+  using Predicate = std::function<bool(
+      typename details::NotifyParameter<Args_>::type...)>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param direct_topics The number of topics found by index, for the keys
+   *        of an integral or enum type. Ignored for the other key types.
+   */
+  explicit EventHub(size_t direct_topics = 256);
+
+  ~EventHub() ATLAS_NOEXCEPT;
+
+  EventHub(const EventHub &) = delete;
+
+  EventHub &operator=(const EventHub &) = delete;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * \return The subject of the topic, created if needed. It lives as long
+   *         as the hub.
+   */
+  Topic &GetTopic(const Key_ &key);
+
+  /**
+   * Attach the observer to the topic.
+   *
+   * \throw std::invalid_argument if it is already subscribed to it.
+   */
+  void Subscribe(const Key_ &key, Observer<Args_...> &observer);
+
+  /**
+   * Attach the observer to the topic, it is only notified of the events for
+   * which the predicate returns true.
+   *
+   * An observer destroyed without Unsubscribe() leaves its filter behind
+   * until the next event of the topic or the next subscription, which remove
+   * it.
+   *
+   * \throw std::invalid_argument if it is already subscribed to it.
+   */
+  void Subscribe(const Key_ &key, Observer<Args_...> &observer,
+                 Predicate predicate);
+
+  /**
+   * \throw std::invalid_argument if the observer is not subscribed to the
+   *        topic.
+   */
+  void Unsubscribe(const Key_ &key, Observer<Args_...> &observer);
+
+  /**
+   * Notify the observers of the topic, if any.
+   */
+  void Publish(const Key_ &key,
+               typename details::NotifyParameter<Args_>::type... args);
+
+  /**
+   * \return The number of subscriptions to the topic.
+   */
+  size_t SubscriberCount(const Key_ &key) const;
+
+  size_t TopicCount() const;
+
+ private:
+  //==========================================================================
+  // P R I V A T E   T Y P E S
+
+  /**
+   * Observes a topic for a subscription with a predicate, and notifies the
+   * subscriber through a subject of its own when the predicate holds.
+   */
+  class Filter : public Observer<Args_...> {
+   public:
+    Filter(EventHub &hub, Predicate predicate);
+
+    ~Filter() ATLAS_NOEXCEPT;
+
+    Topic output;
+
+   protected:
+    void OnSubjectNotify(Topic &topic, Args_... args) override;
+
+   private:
+    EventHub &hub_;
+
+    Predicate predicate_;
+  };
+
+  using TopicMap = std::unordered_map<Key_, std::shared_ptr<Topic>>;
+
+  using FilterKey = std::pair<const Topic *, const Observer<Args_...> *>;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * \return The index of the key in the direct topics, or their count if it
+   *         is not a direct one.
+   */
+  size_t DirectIndex(const Key_ &key) const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The topic, or nullptr if nobody ever subscribed to it.
+   */
+  Topic *FindTopic(const Key_ &key) const ATLAS_NOEXCEPT;
+
+  /**
+   * Remove the filters whose subscriber has been destroyed without
+   * unsubscribing. The mutex_ must not be held.
+   */
+  void PruneFilters();
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /**
+   * The topics found by index. A topic is published once and lives as long
+   * as the hub, so Publish() reads them without locking.
+   */
+  std::unique_ptr<std::atomic<Topic *>[]> direct_topics_;
+
+  size_t direct_topic_count_;
+
+  /**
+   * The other topics. The map is copied on write like the observers of a
+   * Subject, and read with the atomic functions of std::shared_ptr.
+   */
+  std::shared_ptr<const TopicMap> hashed_topics_;
+
+  /**
+   * Owns every topic, in the order of their creation.
+   */
+  std::vector<std::shared_ptr<Topic>> topics_;
+
+  std::map<FilterKey, std::unique_ptr<Filter>> filters_;
+
+  /**
+   * Serializes the creation of the topics and the subscriptions.
+   */
+  mutable std::mutex mutex_;
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/event_hub_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_EVENT_HUB_H_
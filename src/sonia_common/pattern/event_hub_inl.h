@@ -0,0 +1,285 @@
+/**
+ * \file	event_hub_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_EVENT_HUB_H_
+#error This file may only be included from event_hub.h
+#endif
+
+#include <stdexcept>
+
+namespace sonia_common {
+
+namespace details {
+
+template <class Key_>
+ATLAS_ALWAYS_INLINE size_t DirectTopicIndex(const Key_ &key, size_t count,
+                                            std::true_type) ATLAS_NOEXCEPT {
+  // A negative key wraps around to a large index, so it is hashed.
+  const auto index = static_cast<size_t>(key);
+  return index < count ? index : count;
+}
+
+template <class Key_>
+ATLAS_ALWAYS_INLINE size_t DirectTopicIndex(const Key_ &, size_t count,
+                                            std::false_type) ATLAS_NOEXCEPT {
+  return count;
+}
+
+}  // namespace details
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE EventHub<Key_, Args_...>::EventHub(size_t direct_topics)
+    : direct_topics_(),
+      direct_topic_count_(std::is_integral<Key_>::value ||
+                                  std::is_enum<Key_>::value
+                              ? direct_topics
+                              : 0),
+      hashed_topics_(std::make_shared<const TopicMap>()),
+      topics_(),
+      filters_(),
+      mutex_() {
+  direct_topics_.reset(new std::atomic<Topic *>[direct_topic_count_]);
+  for (size_t i = 0; i < direct_topic_count_; ++i) {
+    direct_topics_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE EventHub<Key_, Args_...>::~EventHub() ATLAS_NOEXCEPT {
+  // The filters observe the topics, remove them first.
+  filters_.clear();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE EventHub<Key_, Args_...>::Filter::Filter(EventHub &hub,
+                                                      Predicate predicate)
+    : Observer<Args_...>(),
+      output(),
+      hub_(hub),
+      predicate_(std::move(predicate)) {}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE EventHub<Key_, Args_...>::Filter::~Filter() ATLAS_NOEXCEPT {
+  // Stop the notifications before the output and the predicate go away.
+  this->DetachFromAllSubject();
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE typename EventHub<Key_, Args_...>::Topic &
+EventHub<Key_, Args_...>::GetTopic(const Key_ &key) {
+  Topic *topic = FindTopic(key);
+  if (topic != nullptr) {
+    return *topic;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  topic = FindTopic(key);
+  if (topic != nullptr) {
+    return *topic;
+  }
+
+  auto created = std::make_shared<Topic>();
+  topics_.push_back(created);
+  const size_t index = DirectIndex(key);
+  if (index < direct_topic_count_) {
+    direct_topics_[index].store(created.get(), std::memory_order_release);
+  } else {
+    auto topics = std::make_shared<TopicMap>(*hashed_topics_);
+    topics->emplace(key, created);
+    std::atomic_store(&hashed_topics_,
+                      std::shared_ptr<const TopicMap>(std::move(topics)));
+  }
+  return *created;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE void EventHub<Key_, Args_...>::Subscribe(
+    const Key_ &key, Observer<Args_...> &observer) {
+  PruneFilters();
+  Topic &topic = GetTopic(key);
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (filters_.count(FilterKey(&topic, &observer)) != 0) {
+    throw std::invalid_argument("The observer is already subscribed.");
+  }
+  topic.Attach(observer);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE void EventHub<Key_, Args_...>::Subscribe(
+    const Key_ &key, Observer<Args_...> &observer, Predicate predicate) {
+  // A filter left by a destroyed subscriber may have the same key.
+  PruneFilters();
+  Topic &topic = GetTopic(key);
+  std::lock_guard<std::mutex> guard(mutex_);
+  const FilterKey filter_key(&topic, &observer);
+  if (filters_.count(filter_key) != 0 || observer.IsAttached(topic)) {
+    throw std::invalid_argument("The observer is already subscribed.");
+  }
+
+  std::unique_ptr<Filter> filter(new Filter(*this, std::move(predicate)));
+  filter->output.Attach(observer);
+  topic.Attach(*filter);
+  filters_.emplace(filter_key, std::move(filter));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE void EventHub<Key_, Args_...>::Unsubscribe(
+    const Key_ &key, Observer<Args_...> &observer) {
+  Topic *topic = FindTopic(key);
+  if (topic == nullptr) {
+    throw std::invalid_argument("The observer is not subscribed.");
+  }
+
+  std::unique_ptr<Filter> filter;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = filters_.find(FilterKey(topic, &observer));
+    if (it != filters_.end()) {
+      filter = std::move(it->second);
+      filters_.erase(it);
+    }
+  }
+
+  // Out of the lock: both wait for the notifications in progress, which
+  // may subscribe in their callback.
+  if (filter == nullptr) {
+    topic->Detach(observer);
+  } else {
+    filter.reset();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_ALWAYS_INLINE void EventHub<Key_, Args_...>::Publish(
+    const Key_ &key, typename details::NotifyParameter<Args_>::type... args) {
+  Topic *topic = FindTopic(key);
+  if (topic != nullptr) {
+    topic->Notify(args...);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE size_t
+EventHub<Key_, Args_...>::SubscriberCount(const Key_ &key) const {
+  const Topic *topic = FindTopic(key);
+  return topic == nullptr ? 0 : topic->ObserverCount();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE size_t EventHub<Key_, Args_...>::TopicCount() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return topics_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_ALWAYS_INLINE size_t
+EventHub<Key_, Args_...>::DirectIndex(const Key_ &key) const ATLAS_NOEXCEPT {
+  return details::DirectTopicIndex(
+      key, direct_topic_count_,
+      std::integral_constant<bool, std::is_integral<Key_>::value ||
+                                       std::is_enum<Key_>::value>());
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_ALWAYS_INLINE typename EventHub<Key_, Args_...>::Topic *
+EventHub<Key_, Args_...>::FindTopic(const Key_ &key) const ATLAS_NOEXCEPT {
+  const size_t index = DirectIndex(key);
+  if (index < direct_topic_count_) {
+    return direct_topics_[index].load(std::memory_order_acquire);
+  }
+
+  const auto topics = std::atomic_load(&hashed_topics_);
+  const auto it = topics->find(key);
+  return it == topics->end() ? nullptr : it->second.get();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE void EventHub<Key_, Args_...>::PruneFilters() {
+  std::vector<std::unique_ptr<Filter>> pruned;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (auto it = filters_.begin(); it != filters_.end();) {
+      if (it->second->output.ObserverCount() == 0) {
+        pruned.push_back(std::move(it->second));
+        it = filters_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  // Destroyed out of the lock, as in Unsubscribe().
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Key_, typename... Args_>
+ATLAS_INLINE void EventHub<Key_, Args_...>::Filter::OnSubjectNotify(
+    Topic &, Args_... args) {
+  if (output.ObserverCount() == 0) {
+    // The subscriber was destroyed without unsubscribing. This destroys the
+    // filter: nothing of it may be used past this call.
+    hub_.PruneFilters();
+    return;
+  }
+  if (predicate_(args...)) {
+    output.Notify(args...);
+  }
+}
+
+}  // namespace sonia_common
@@ -0,0 +1,286 @@
+/**
+ * \file	future.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_FUTURE_H_
+#define SONIA_COMMON_PATTERN_FUTURE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/task.h>
+#include <sonia_common/pattern/thread_pool.h>
+
+namespace sonia_common {
+
+template <class Tp_>
+class Future;
+
+template <class Tp_>
+class Promise;
+
+namespace details {
+
+template <class Tp_>
+class FutureState;
+
+/**
+ * The type a continuation of a Future<Tp_> returns. The continuation takes
+ * the value of the future, or nothing for a Future<void>.
+ */
+template <class Tp_, class Fp_>
+struct ContinuationResult {
+  using type = typename std::result_of<Fp_ &(const Tp_ &)>::type;
+};
+
+template <class Fp_>
+struct ContinuationResult<void, Fp_> {
+  using type = typename std::result_of<Fp_ &()>::type;
+};
+
+/**
+ * What Future<Tp_>::Get() returns: a reference on the value, if any.
+ */
+template <class Tp_>
+struct FutureGetType {
+  using type = const Tp_ &;
+};
+
+template <>
+struct FutureGetType<void> {
+  using type = void;
+};
+
+}  // namespace details
+
+//==============================================================================
+// C L A S S E S
+
+/**
+ * A future that can be chained without blocking any thread.
+ *
+ * Unlike std::future, a Future can register continuations with Then(): they
+ * are called with the value as soon as it is set, either on the thread that
+ * sets it or on a ThreadPool. The result of a continuation is itself a
+ * Future, so the stages of a pipeline can be chained and joined with
+ * WhenAll() and WhenAny() without parking a worker in Get().
+ *
+ * A Future can be copied, all the copies share the same state, like a
+ * std::shared_future.
+ */
+template <class Tp_>
+class Future {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using ValueType = Tp_;
+
+  using GetType = typename details::FutureGetType<Tp_>::type;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Create an invalid future, with no state.
+   */
+  Future() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * \return Either if this future is attached to a promise.
+   */
+  bool IsValid() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return Either if the value or an exception has been set.
+   */
+  bool IsReady() const ATLAS_NOEXCEPT;
+
+  /**
+   * Block the calling thread until the future is ready.
+   */
+  void Wait() const;
+
+  /**
+   * Wait until the future is ready, running the pending tasks of the pool
+   * in the meantime. Use this from inside a task of that pool.
+   */
+  void Wait(ThreadPool &pool) const;
+
+  /**
+   * Wait until the future is ready, then return the value or rethrow the
+   * exception that has been set.
+   */
+  GetType Get() const;
+
+  /**
+   * Call f with the value once it is set, on the thread that sets it, or
+   * right away if it is already set.
+   *
+   * If an exception is set instead, f is not called and the exception is
+   * forwarded to the returned future.
+   * Keep such continuations short, they run on the producer thread.
+   *
+   * \return A future on the result of f.
+   */
+  template <class Fp_>
+  Future<typename details::ContinuationResult<Tp_, Fp_>::type> Then(Fp_ &&f);
+
+  /**
+   * Same as Then(f), but f is enqueued on the pool when the value is set.
+   */
+  template <class Fp_>
+  Future<typename details::ContinuationResult<Tp_, Fp_>::type> Then(
+      ThreadPool &pool, Fp_ &&f);
+
+ private:
+  //============================================================================
+  // P R I V A T E   C / D T O R S
+
+  friend class Promise<Tp_>;
+
+  template <class Up_>
+  friend class Future;
+
+  template <class Up_>
+  friend Future<std::vector<Future<Up_>>> WhenAll(
+      const std::vector<Future<Up_>> &futures);
+
+  template <class Up_>
+  friend Future<size_t> WhenAny(const std::vector<Future<Up_>> &futures);
+
+  explicit Future(const std::shared_ptr<details::FutureState<Tp_>> &state)
+      ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  const std::shared_ptr<details::FutureState<Tp_>> &State() const;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::shared_ptr<details::FutureState<Tp_>> state_;
+};
+
+/**
+ * The producer side of a Future.
+ *
+ * A Promise can be moved but not copied. If it is destroyed before a value
+ * or an exception has been set, its future receives a broken_promise
+ * std::future_error.
+ */
+template <class Tp_>
+class Promise {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  Promise();
+
+  Promise(Promise &&rhs) ATLAS_NOEXCEPT;
+
+  Promise(const Promise &) = delete;
+
+  ~Promise() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  Promise &operator=(Promise &&rhs) ATLAS_NOEXCEPT;
+
+  Promise &operator=(const Promise &) = delete;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  Future<Tp_> GetFuture() const;
+
+  /**
+   * Set the value of the future, constructed from the given arguments -- none
+   * for a Promise<void>. Throws a std::future_error if the future is
+   * already satisfied.
+   */
+  template <class... Args_>
+  void SetValue(Args_ &&... args);
+
+  void SetException(std::exception_ptr error);
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::shared_ptr<details::FutureState<Tp_>> state_;
+};
+
+//==============================================================================
+// F U N C T I O N S
+
+/**
+ * Run f(args...) on the pool.
+ *
+ * \return A future on the result of the call.
+ */
+template <class Fp_, class... Args_>
+Future<typename std::result_of<Fp_(Args_...)>::type> Async(ThreadPool &pool,
+                                                           Fp_ &&f,
+                                                           Args_ &&... args);
+
+/**
+ * \return A future that is ready when all the given futures are, even if
+ *         some of them hold an exception. Its value is the given futures.
+ */
+template <class Tp_>
+Future<std::vector<Future<Tp_>>> WhenAll(
+    const std::vector<Future<Tp_>> &futures);
+
+/**
+ * \return A future on the index of the first of the given futures to be
+ *         ready. Throws a std::invalid_argument if there is no future.
+ */
+template <class Tp_>
+Future<size_t> WhenAny(const std::vector<Future<Tp_>> &futures);
+
+/**
+ * \return A future that is already ready with the given value.
+ */
+template <class Tp_>
+Future<typename std::decay<Tp_>::type> MakeReadyFuture(Tp_ &&value);
+
+Future<void> MakeReadyFuture();
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/future_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_FUTURE_H_
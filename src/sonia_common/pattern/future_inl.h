@@ -0,0 +1,568 @@
+/**
+ * \file	future_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_FUTURE_H_
+#error This file may only be included from future.h
+#endif
+
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <utility>
+
+namespace sonia_common {
+
+namespace details {
+
+//==============================================================================
+// D E T A I L S   S E C T I O N
+
+/**
+ * The storage of the value of a future, constructed in place once it is set.
+ */
+template <class Tp_>
+class FutureValue {
+ public:
+  FutureValue() ATLAS_NOEXCEPT : has_value_(false) {}
+
+  FutureValue(const FutureValue &) = delete;
+
+  ~FutureValue() ATLAS_NOEXCEPT {
+    if (has_value_) {
+      reinterpret_cast<Tp_ *>(&storage_)->~Tp_();
+    }
+  }
+
+  FutureValue &operator=(const FutureValue &) = delete;
+
+  template <class... Args_>
+  void Emplace(Args_ &&... args) {
+    new (&storage_) Tp_(std::forward<Args_>(args)...);
+    has_value_ = true;
+  }
+
+  const Tp_ &Get() const ATLAS_NOEXCEPT {
+    return *reinterpret_cast<const Tp_ *>(&storage_);
+  }
+
+  template <class Fp_>
+  static auto Invoke(Fp_ &f, const FutureValue &value)
+      -> decltype(f(value.Get())) {
+    return f(value.Get());
+  }
+
+ private:
+  typename std::aligned_storage<sizeof(Tp_), alignof(Tp_)>::type storage_;
+  bool has_value_;
+};
+
+template <>
+class FutureValue<void> {
+ public:
+  void Emplace() ATLAS_NOEXCEPT {}
+
+  void Get() const ATLAS_NOEXCEPT {}
+
+  template <class Fp_>
+  static auto Invoke(Fp_ &f, const FutureValue &) -> decltype(f()) {
+    return f();
+  }
+};
+
+/**
+ * The state shared by a promise and its futures.
+ */
+template <class Tp_>
+class FutureState {
+ public:
+  FutureState()
+      : mutex_(),
+        condition_(),
+        ready_(false),
+        error_(),
+        value_(),
+        continuations_() {}
+
+  bool IsReady() const ATLAS_NOEXCEPT {
+    return ready_.load(std::memory_order_acquire);
+  }
+
+  void Wait() const {
+    if (IsReady()) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return IsReady(); });
+  }
+
+  void Wait(ThreadPool &pool) const {
+    while (!IsReady()) {
+      if (!pool.RunPendingTask()) {
+        // Nothing left to help with, the value is produced by a task that is
+        // already running, or outside of the pool.
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait_for(lock, std::chrono::microseconds(100),
+                            [this] { return IsReady(); });
+      }
+    }
+  }
+
+  template <class... Args_>
+  void SetValue(Args_ &&... args) {
+    std::vector<Task> continuations;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      ThrowIfReady();
+      value_.Emplace(std::forward<Args_>(args)...);
+      MarkReady(continuations);
+    }
+    Resume(continuations);
+  }
+
+  void SetException(std::exception_ptr error) {
+    std::vector<Task> continuations;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      ThrowIfReady();
+      error_ = error;
+      MarkReady(continuations);
+    }
+    Resume(continuations);
+  }
+
+  /**
+   * Run the task once the state is ready, right away if it already is.
+   */
+  void AddContinuation(Task &&task) {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (!IsReady()) {
+        continuations_.push_back(std::move(task));
+        return;
+      }
+    }
+    task();
+  }
+
+  /**
+   * The state must be ready. Rethrow the exception if one has been set.
+   */
+  const FutureValue<Tp_> &Value() const {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return value_;
+  }
+
+  std::exception_ptr Error() const ATLAS_NOEXCEPT { return error_; }
+
+ private:
+  void ThrowIfReady() const {
+    if (IsReady()) {
+      throw std::future_error(std::future_errc::promise_already_satisfied);
+    }
+  }
+
+  void MarkReady(std::vector<Task> &continuations) {
+    ready_.store(true, std::memory_order_release);
+    continuations.swap(continuations_);
+    condition_.notify_all();
+  }
+
+  static void Resume(std::vector<Task> &continuations) {
+    for (auto &continuation : continuations) {
+      continuation();
+    }
+  }
+
+  mutable std::mutex mutex_;
+  mutable std::condition_variable condition_;
+  std::atomic<bool> ready_;
+  std::exception_ptr error_;
+  FutureValue<Tp_> value_;
+  std::vector<Task> continuations_;
+};
+
+/**
+ * Set the result of f on a promise, whether it returns a value or not.
+ */
+template <class Rp_>
+struct Fulfill {
+  template <class Fp_, class... Args_>
+  static void Call(Promise<Rp_> &promise, Fp_ &f, Args_ &&... args) {
+    promise.SetValue(f(std::forward<Args_>(args)...));
+  }
+
+  template <class Tp_, class Fp_>
+  static void Continue(Promise<Rp_> &promise, Fp_ &f,
+                       const FutureValue<Tp_> &value) {
+    promise.SetValue(FutureValue<Tp_>::Invoke(f, value));
+  }
+};
+
+template <>
+struct Fulfill<void> {
+  template <class Fp_, class... Args_>
+  static void Call(Promise<void> &promise, Fp_ &f, Args_ &&... args) {
+    f(std::forward<Args_>(args)...);
+    promise.SetValue();
+  }
+
+  template <class Tp_, class Fp_>
+  static void Continue(Promise<void> &promise, Fp_ &f,
+                       const FutureValue<Tp_> &value) {
+    FutureValue<Tp_>::Invoke(f, value);
+    promise.SetValue();
+  }
+};
+
+/**
+ * The task that calls a continuation with the value of its source and sets
+ * the result on the promise of the future returned by Then().
+ */
+template <class Tp_, class Rp_, class Fp_>
+class Continuation {
+ public:
+  Continuation(const std::shared_ptr<FutureState<Tp_>> &source,
+               Promise<Rp_> &&promise, Fp_ &&f)
+      : source_(source), promise_(std::move(promise)), f_(std::move(f)) {}
+
+  void operator()() {
+    if (source_->Error()) {
+      promise_.SetException(source_->Error());
+      return;
+    }
+    try {
+      Fulfill<Rp_>::Continue(promise_, f_, source_->Value());
+    } catch (...) {
+      promise_.SetException(std::current_exception());
+    }
+  }
+
+ private:
+  std::shared_ptr<FutureState<Tp_>> source_;
+  Promise<Rp_> promise_;
+  Fp_ f_;
+};
+
+/**
+ * Enqueue a task on a pool when it is called.
+ */
+template <class Fp_>
+class Dispatch {
+ public:
+  Dispatch(ThreadPool &pool, Fp_ &&f) : pool_(&pool), f_(std::move(f)) {}
+
+  void operator()() {
+    try {
+      pool_->EnqueueDetached(std::move(f_));
+    } catch (...) {
+      // The pool is stopped. The continuation has been destroyed with its
+      // promise, so the future returned by Then() holds a broken_promise.
+    }
+  }
+
+ private:
+  ThreadPool *pool_;
+  Fp_ f_;
+};
+
+/**
+ * The task created by Async().
+ */
+template <class Rp_, class Fp_>
+class AsyncCall {
+ public:
+  AsyncCall(Promise<Rp_> &&promise, Fp_ &&f)
+      : promise_(std::move(promise)), f_(std::move(f)) {}
+
+  void operator()() {
+    try {
+      Fulfill<Rp_>::Call(promise_, f_);
+    } catch (...) {
+      promise_.SetException(std::current_exception());
+    }
+  }
+
+ private:
+  Promise<Rp_> promise_;
+  Fp_ f_;
+};
+
+template <class Tp_>
+struct WhenAllContext {
+  explicit WhenAllContext(const std::vector<Future<Tp_>> &inputs)
+      : remaining(inputs.size()), futures(inputs), promise() {}
+
+  std::atomic<size_t> remaining;
+  std::vector<Future<Tp_>> futures;
+  Promise<std::vector<Future<Tp_>>> promise;
+};
+
+struct WhenAnyContext {
+  WhenAnyContext() : done(false), promise() {}
+
+  std::atomic<bool> done;
+  Promise<size_t> promise;
+};
+
+}  // namespace details
+
+//==============================================================================
+// C / D T O R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Future<Tp_>::Future() ATLAS_NOEXCEPT : state_() {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Future<Tp_>::Future(
+    const std::shared_ptr<details::FutureState<Tp_>> &state) ATLAS_NOEXCEPT
+    : state_(state) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Promise<Tp_>::Promise()
+    : state_(std::make_shared<details::FutureState<Tp_>>()) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Promise<Tp_>::Promise(Promise &&rhs) ATLAS_NOEXCEPT
+    : state_(std::move(rhs.state_)) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Promise<Tp_>::~Promise() ATLAS_NOEXCEPT {
+  if (state_ && !state_->IsReady()) {
+    try {
+      state_->SetException(std::make_exception_ptr(
+          std::future_error(std::future_errc::broken_promise)));
+    } catch (...) {
+      // A continuation threw while being resumed, nothing else to do.
+    }
+  }
+}
+
+//==============================================================================
+// O P E R A T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Promise<Tp_> &Promise<Tp_>::operator=(Promise &&rhs)
+    ATLAS_NOEXCEPT {
+  Promise(std::move(rhs)).state_.swap(state_);
+  return *this;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool Future<Tp_>::IsValid() const ATLAS_NOEXCEPT {
+  return state_ != nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool Future<Tp_>::IsReady() const ATLAS_NOEXCEPT {
+  return state_ && state_->IsReady();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void Future<Tp_>::Wait() const {
+  State()->Wait();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void Future<Tp_>::Wait(ThreadPool &pool) const {
+  State()->Wait(pool);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE typename Future<Tp_>::GetType Future<Tp_>::Get() const {
+  State()->Wait();
+  return state_->Value().Get();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class Fp_>
+ATLAS_INLINE Future<typename details::ContinuationResult<Tp_, Fp_>::type>
+Future<Tp_>::Then(Fp_ &&f) {
+  using Result = typename details::ContinuationResult<Tp_, Fp_>::type;
+  using Callable = typename std::decay<Fp_>::type;
+
+  Promise<Result> promise;
+  Future<Result> future = promise.GetFuture();
+  State()->AddContinuation(Task(details::Continuation<Tp_, Result, Callable>(
+      state_, std::move(promise), Callable(std::forward<Fp_>(f)))));
+  return future;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class Fp_>
+ATLAS_INLINE Future<typename details::ContinuationResult<Tp_, Fp_>::type>
+Future<Tp_>::Then(ThreadPool &pool, Fp_ &&f) {
+  using Result = typename details::ContinuationResult<Tp_, Fp_>::type;
+  using Callable = typename std::decay<Fp_>::type;
+  using Step = details::Continuation<Tp_, Result, Callable>;
+
+  Promise<Result> promise;
+  Future<Result> future = promise.GetFuture();
+  State()->AddContinuation(Task(details::Dispatch<Step>(
+      pool,
+      Step(state_, std::move(promise), Callable(std::forward<Fp_>(f))))));
+  return future;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE const std::shared_ptr<details::FutureState<Tp_>>
+    &Future<Tp_>::State() const {
+  if (!state_) {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  return state_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Future<Tp_> Promise<Tp_>::GetFuture() const {
+  return Future<Tp_>(state_);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+template <class... Args_>
+ATLAS_INLINE void Promise<Tp_>::SetValue(Args_ &&... args) {
+  state_->SetValue(std::forward<Args_>(args)...);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void Promise<Tp_>::SetException(std::exception_ptr error) {
+  state_->SetException(error);
+}
+
+//==============================================================================
+// F U N C T I O N S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_, class... Args_>
+ATLAS_INLINE Future<typename std::result_of<Fp_(Args_...)>::type> Async(
+    ThreadPool &pool, Fp_ &&f, Args_ &&... args) {
+  using Result = typename std::result_of<Fp_(Args_...)>::type;
+  auto call = std::bind(std::forward<Fp_>(f), std::forward<Args_>(args)...);
+
+  Promise<Result> promise;
+  Future<Result> future = promise.GetFuture();
+  pool.EnqueueDetached(details::AsyncCall<Result, decltype(call)>(
+      std::move(promise), std::move(call)));
+  return future;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Future<std::vector<Future<Tp_>>> WhenAll(
+    const std::vector<Future<Tp_>> &futures) {
+  auto context = std::make_shared<details::WhenAllContext<Tp_>>(futures);
+  Future<std::vector<Future<Tp_>>> result = context->promise.GetFuture();
+  if (futures.empty()) {
+    context->promise.SetValue();
+    return result;
+  }
+  for (const auto &future : futures) {
+    future.State()->AddContinuation(Task([context] {
+      if (context->remaining.fetch_sub(1) == 1) {
+        context->promise.SetValue(std::move(context->futures));
+      }
+    }));
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Future<size_t> WhenAny(const std::vector<Future<Tp_>> &futures) {
+  if (futures.empty()) {
+    throw std::invalid_argument("WhenAny needs at least one future");
+  }
+  auto context = std::make_shared<details::WhenAnyContext>();
+  Future<size_t> result = context->promise.GetFuture();
+  for (size_t i = 0; i < futures.size(); ++i) {
+    futures[i].State()->AddContinuation(Task([context, i] {
+      if (!context->done.exchange(true)) {
+        context->promise.SetValue(i);
+      }
+    }));
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE Future<typename std::decay<Tp_>::type> MakeReadyFuture(
+    Tp_ &&value) {
+  Promise<typename std::decay<Tp_>::type> promise;
+  promise.SetValue(std::forward<Tp_>(value));
+  return promise.GetFuture();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Future<void> MakeReadyFuture() {
+  Promise<void> promise;
+  promise.SetValue();
+  return promise.GetFuture();
+}
+
+}  // namespace sonia_common
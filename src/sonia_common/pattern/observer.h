@@ -29,7 +29,9 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 #include <sonia_common/macros.h>
@@ -87,6 +89,18 @@ class Observer {
 
   void DetachFromAllSubject() ATLAS_NOEXCEPT;
 
+  /**
+   * Name the observer in the traces of the subjects, see
+   * Subject::EnableTracing(). The subjects read the name when they report
+   * their traces, so it can be set at any time.
+   */
+  void SetName(const std::string &name);
+
+  /**
+   * \return The name given with SetName(), or the type of the observer.
+   */
+  std::string GetName() const;
+
  protected:
   //============================================================================
   // P R O T E C T E D   M E T H O D S
@@ -106,14 +120,30 @@ class Observer {
 
   virtual void OnSubjectDisconnected(Subject<Args_...> &subject);
 
+  /**
+   * \return A copy of the subjects this observer is attached to.
+   */
+  std::vector<Subject<Args_...> *> Subjects() const;
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
-  std::vector<Subject<Args_...> *> subjects_;
+  std::unordered_set<Subject<Args_...> *> subjects_;
+
+  std::string name_;
 
+  /**
+   * Guards the subjects_ and the name_.
+   */
   mutable std::mutex subjects_mutex_;
 };
 
+/**
+ * An observer of a SharedSubject.
+ */
+template <typename Tp_>
+using SharedObserver = Observer<const std::shared_ptr<const Tp_> &>;
+
 }  // namespace sonia_common
 
 #include <sonia_common/pattern/observer_inl.h>
@@ -29,6 +29,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <stdexcept>
+#include <typeinfo>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
 
 namespace sonia_common {
 
@@ -40,6 +46,7 @@ namespace sonia_common {
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer() ATLAS_NOEXCEPT
     : subjects_(),
+      name_(),
       subjects_mutex_() {}
 
 //------------------------------------------------------------------------------
@@ -47,8 +54,13 @@ ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer() ATLAS_NOEXCEPT
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer(const Observer<Args_...> &rhs)
     ATLAS_NOEXCEPT : subjects_(),
+                     name_(),
                      subjects_mutex_() {
-  for (auto &subject : rhs.subjects_) {
+  {
+    std::lock_guard<std::mutex> guard(rhs.subjects_mutex_);
+    name_ = rhs.name_;
+  }
+  for (auto &subject : rhs.Subjects()) {
     subject->Attach(*this);
   }
 }
@@ -58,6 +70,7 @@ ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer(const Observer<Args_...> &rhs)
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer(Subject<Args_...> &subject)
     ATLAS_NOEXCEPT : subjects_(),
+                     name_(),
                      subjects_mutex_() {
   subject.Attach(*this);
 }
@@ -66,8 +79,12 @@ ATLAS_ALWAYS_INLINE Observer<Args_...>::Observer(Subject<Args_...> &subject)
 //
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Observer<Args_...>::~Observer() ATLAS_NOEXCEPT {
-  for (const auto &subject : subjects_) {
-    subject->DetachNoCallback(*this);
+  for (const auto &subject : Subjects()) {
+    try {
+      subject->DetachNoCallback(*this);
+    } catch (const std::invalid_argument &) {
+      // The subject detached us meanwhile.
+    }
   }
 }
 
@@ -80,7 +97,7 @@ template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Observer<Args_...>::operator=(
     const Observer<Args_...> &rhs) ATLAS_NOEXCEPT {
   DetachFromAllSubject();
-  for (auto &subject : rhs.subjects_) {
+  for (auto &subject : rhs.Subjects()) {
     subject->Attach(*this);
   }
 }
@@ -93,11 +110,47 @@ ATLAS_ALWAYS_INLINE void Observer<Args_...>::operator=(
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Observer<Args_...>::DetachFromAllSubject()
     ATLAS_NOEXCEPT {
-  // Do not lock the mutex here because it will be in OnSubjectDisconnected().
-  for (const auto &subject : subjects_) {
-    subject->Detach(*this);
+  // Work on a copy, OnSubjectDisconnected() removes the subjects from the
+  // set while we iterate.
+  for (const auto &subject : Subjects()) {
+    try {
+      subject->Detach(*this);
+    } catch (const std::invalid_argument &) {
+      // The subject detached us meanwhile.
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Observer<Args_...>::SetName(const std::string &name) {
+  std::lock_guard<std::mutex> guard(subjects_mutex_);
+  name_ = name;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE std::string Observer<Args_...>::GetName() const {
+  {
+    std::lock_guard<std::mutex> guard(subjects_mutex_);
+    if (!name_.empty()) {
+      return name_;
+    }
+  }
+
+  const char *type = typeid(*this).name();
+#if defined(__GNUG__)
+  int status = 0;
+  char *demangled = abi::__cxa_demangle(type, nullptr, nullptr, &status);
+  if (status == 0 && demangled != nullptr) {
+    std::string name(demangled);
+    std::free(demangled);
+    return name;
   }
-  subjects_.clear();
+#endif
+  return type;
 }
 
 //------------------------------------------------------------------------------
@@ -106,11 +159,8 @@ template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Observer<Args_...>::OnSubjectConnected(
     Subject<Args_...> &subject) {
   std::unique_lock<std::mutex> locker(subjects_mutex_);
-  auto it = std::find(subjects_.begin(), subjects_.end(), &subject);
-  if (it != subjects_.end()) {
+  if (!subjects_.insert(&subject).second) {
     throw std::invalid_argument("The element is already in the container.");
-  } else {
-    subjects_.push_back(&subject);
   }
 }
 
@@ -120,11 +170,8 @@ template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Observer<Args_...>::OnSubjectDisconnected(
     Subject<Args_...> &subject) {
   std::unique_lock<std::mutex> locker(subjects_mutex_);
-  auto it = std::find(subjects_.begin(), subjects_.end(), &subject);
-  if (it == subjects_.end()) {
+  if (subjects_.erase(&subject) == 0) {
     throw std::invalid_argument("The element is not in the container.");
-  } else {
-    subjects_.erase(it);
   }
 }
 
@@ -134,8 +181,16 @@ template <typename... Args_>
 ATLAS_ALWAYS_INLINE bool Observer<Args_...>::IsAttached(
     const Subject<Args_...> &subject) const ATLAS_NOEXCEPT {
   std::unique_lock<std::mutex> locker(subjects_mutex_);
-  return std::find(subjects_.begin(), subjects_.end(), &subject) !=
-         subjects_.end();
+  return subjects_.count(const_cast<Subject<Args_...> *>(&subject)) != 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE std::vector<Subject<Args_...> *>
+Observer<Args_...>::Subjects() const {
+  std::unique_lock<std::mutex> locker(subjects_mutex_);
+  return std::vector<Subject<Args_...> *>(subjects_.begin(), subjects_.end());
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,193 @@
+/**
+ * \file	periodic_runnable.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_PERIODIC_RUNNABLE_H_
+#define SONIA_COMMON_PATTERN_PERIODIC_RUNNABLE_H_
+
+#include <time.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/runnable.h>
+
+namespace sonia_common {
+
+/**
+ * A Runnable that calls Step() at a fixed rate, for the control loops.
+ *
+ * Rather than sleeping for the period after each step, which drifts by the
+ * duration of the step and of the wake up, the thread sleeps until absolute
+ * deadlines on the monotonic clock, polling the stop event with the time
+ * left. The deadlines stay on a fixed grid, whatever the duration of the
+ * steps.
+ *
+ * The lateness of each wake up, the jitter, and the duration of each step
+ * are measured, and the steps that end after the next deadline are counted
+ * as overruns. What happens after an overrun is set by the OverrunPolicy.
+ *
+ * Stop() wakes the sleep, and returns once the current step is done.
+ * Each step is a Heartbeat() for the Supervisor.
+ *
+ * Sample usage:
+ *
+ * class DepthController : public PeriodicRunnable {
+ *  public:
+ *   DepthController() : PeriodicRunnable(std::chrono::milliseconds(10)) {}
+ *  protected:
+ *   void Step() override { thrusters_.Apply(pid_.Update(depth_.Read())); }
+ * };
+ */
+class PeriodicRunnable : public Runnable {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<PeriodicRunnable>;
+
+  using Clock = std::chrono::steady_clock;
+
+  enum class OverrunPolicy {
+    /**
+     * Run the missed steps right away, back to back, until the loop is back
+     * on schedule. Use it when every step counts, e.g. an integrator.
+     */
+    kCatchUp,
+
+    /**
+     * Drop the missed steps and wait for the next deadline of the grid. Use
+     * it when only the latest state matters, e.g. a controller.
+     */
+    kSkip
+  };
+
+  struct Statistics {
+    uint64_t steps;
+
+    /**
+     * The steps that ended after the deadline of the next one.
+     */
+    uint64_t overruns;
+
+    /**
+     * The steps dropped by the kSkip policy.
+     */
+    uint64_t skipped;
+
+    /**
+     * How late the thread woke up after the deadlines.
+     */
+    Clock::duration max_jitter;
+
+    Clock::duration mean_jitter;
+
+    Clock::duration max_step_time;
+
+    Clock::duration mean_step_time;
+  };
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \throw std::invalid_argument if the period is not positive.
+   */
+  explicit PeriodicRunnable(Clock::duration period,
+                            OverrunPolicy policy = OverrunPolicy::kSkip);
+
+  PeriodicRunnable(Clock::duration period, OverrunPolicy policy,
+                   const ThreadOptions &options);
+
+  ~PeriodicRunnable() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  Clock::duration GetPeriod() const ATLAS_NOEXCEPT;
+
+  OverrunPolicy GetOverrunPolicy() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The statistics since the loop started or the last reset. They
+   *         can be read while the loop runs.
+   */
+  Statistics GetStatistics() const ATLAS_NOEXCEPT;
+
+  void ResetStatistics() ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  /**
+   * The work to do at each period, called from the thread of the Runnable.
+   */
+  virtual void Step() = 0;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void Run() final;
+
+  static int64_t Now() ATLAS_NOEXCEPT;
+
+  /**
+   * Sleep until the deadline, in nanoseconds on CLOCK_MONOTONIC, or until
+   * Stop() is called.
+   */
+  void SleepUntil(int64_t deadline) const ATLAS_NOEXCEPT;
+
+  static void RaiseMax(std::atomic<int64_t> &max, int64_t value) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  const int64_t period_;
+
+  const OverrunPolicy policy_;
+
+  std::atomic<uint64_t> steps_;
+
+  std::atomic<uint64_t> overruns_;
+
+  std::atomic<uint64_t> skipped_;
+
+  // In nanoseconds.
+  std::atomic<int64_t> max_jitter_;
+
+  std::atomic<int64_t> total_jitter_;
+
+  std::atomic<int64_t> max_step_time_;
+
+  std::atomic<int64_t> total_step_time_;
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/periodic_runnable_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_PERIODIC_RUNNABLE_H_
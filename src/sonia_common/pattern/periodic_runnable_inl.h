@@ -0,0 +1,222 @@
+/**
+ * \file	periodic_runnable_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_PERIODIC_RUNNABLE_H_
+#error This file may only be included from periodic_runnable.h
+#endif
+
+#include <poll.h>
+#include <cerrno>
+#include <stdexcept>
+
+namespace sonia_common {
+
+//==============================================================================
+// C / D T O R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE PeriodicRunnable::PeriodicRunnable(Clock::duration period,
+                                                OverrunPolicy policy)
+    : PeriodicRunnable(period, policy, ThreadOptions()) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE PeriodicRunnable::PeriodicRunnable(Clock::duration period,
+                                                OverrunPolicy policy,
+                                                const ThreadOptions &options)
+    : Runnable(options),
+      period_(std::chrono::duration_cast<std::chrono::nanoseconds>(period)
+                  .count()),
+      policy_(policy),
+      steps_(0),
+      overruns_(0),
+      skipped_(0),
+      max_jitter_(0),
+      total_jitter_(0),
+      max_step_time_(0),
+      total_step_time_(0) {
+  if (period_ <= 0) {
+    throw std::invalid_argument("The period must be positive.");
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE PeriodicRunnable::~PeriodicRunnable() ATLAS_NOEXCEPT {
+  // Step() is pure virtual: stop the loop before this part is destroyed.
+  if (IsRunning()) {
+    Stop();
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE PeriodicRunnable::Clock::duration PeriodicRunnable::GetPeriod()
+    const ATLAS_NOEXCEPT {
+  return std::chrono::duration_cast<Clock::duration>(
+      std::chrono::nanoseconds(period_));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE PeriodicRunnable::OverrunPolicy
+PeriodicRunnable::GetOverrunPolicy() const ATLAS_NOEXCEPT {
+  return policy_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE PeriodicRunnable::Statistics PeriodicRunnable::GetStatistics()
+    const ATLAS_NOEXCEPT {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+
+  Statistics statistics;
+  statistics.steps = steps_;
+  statistics.overruns = overruns_;
+  statistics.skipped = skipped_;
+  const int64_t steps =
+      statistics.steps == 0 ? 1 : static_cast<int64_t>(statistics.steps);
+  statistics.max_jitter =
+      duration_cast<Clock::duration>(nanoseconds(max_jitter_.load()));
+  statistics.mean_jitter =
+      duration_cast<Clock::duration>(nanoseconds(total_jitter_ / steps));
+  statistics.max_step_time =
+      duration_cast<Clock::duration>(nanoseconds(max_step_time_.load()));
+  statistics.mean_step_time =
+      duration_cast<Clock::duration>(nanoseconds(total_step_time_ / steps));
+  return statistics;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void PeriodicRunnable::ResetStatistics() ATLAS_NOEXCEPT {
+  steps_ = 0;
+  overruns_ = 0;
+  skipped_ = 0;
+  max_jitter_ = 0;
+  total_jitter_ = 0;
+  max_step_time_ = 0;
+  total_step_time_ = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void PeriodicRunnable::Run() {
+  ResetStatistics();
+
+  int64_t deadline = Now();
+  while (!MustStop()) {
+    deadline += period_;
+    SleepUntil(deadline);
+    if (MustStop()) {
+      break;
+    }
+
+    const int64_t start = Now();
+    Step();
+    const int64_t end = Now();
+
+    const int64_t jitter = start - deadline;
+    const int64_t step_time = end - start;
+    steps_.fetch_add(1, std::memory_order_relaxed);
+    total_jitter_.fetch_add(jitter, std::memory_order_relaxed);
+    total_step_time_.fetch_add(step_time, std::memory_order_relaxed);
+    RaiseMax(max_jitter_, jitter);
+    RaiseMax(max_step_time_, step_time);
+    Heartbeat();
+
+    if (end > deadline + period_) {
+      overruns_.fetch_add(1, std::memory_order_relaxed);
+      if (policy_ == OverrunPolicy::kSkip) {
+        // Move to the last deadline passed, the next one is in the future.
+        const int64_t missed = (end - deadline) / period_;
+        skipped_.fetch_add(static_cast<uint64_t>(missed),
+                           std::memory_order_relaxed);
+        deadline += missed * period_;
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t PeriodicRunnable::Now() ATLAS_NOEXCEPT {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void PeriodicRunnable::SleepUntil(int64_t deadline) const
+    ATLAS_NOEXCEPT {
+  pollfd stop_event;
+  stop_event.fd = GetStopEvent();
+  stop_event.events = POLLIN;
+  stop_event.revents = 0;
+  for (;;) {
+    const int64_t remaining = deadline - Now();
+    if (remaining <= 0) {
+      return;
+    }
+    timespec time;
+    time.tv_sec = static_cast<time_t>(remaining / 1000000000);
+    time.tv_nsec = static_cast<long>(remaining % 1000000000);
+    // The stop event stays readable once Stop() is called, and a negative
+    // descriptor is ignored. The timeout is relative: after a signal or an
+    // early return, sleep what is left.
+    const int result = ppoll(&stop_event, 1, &time, nullptr);
+    if (result > 0) {
+      return;
+    }
+    if (result < 0 && errno != EINTR) {
+      // ppoll() is not usable, fall back to a plain sleep.
+      time.tv_sec = static_cast<time_t>(deadline / 1000000000);
+      time.tv_nsec = static_cast<long>(deadline % 1000000000);
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time,
+                             nullptr) == EINTR) {
+      }
+      return;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void PeriodicRunnable::RaiseMax(std::atomic<int64_t> &max,
+                                             int64_t value) ATLAS_NOEXCEPT {
+  int64_t current = max.load(std::memory_order_relaxed);
+  while (value > current &&
+         !max.compare_exchange_weak(current, value,
+                                    std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace sonia_common
@@ -27,8 +27,16 @@
 #define SONIA_COMMON_PATTERN_RUNNABLE_H_
 
 #include <sonia_common/macros.h>
+#include <sonia_common/sys/latency_histogram.h>
+#include <sonia_common/sys/thread_options.h>
+#include <sys/types.h>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 
 namespace sonia_common {
@@ -50,11 +58,79 @@ class Runnable {
 
   using Ptr = std::shared_ptr<Runnable>;
 
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * How the thread of a profiled Runnable spent its time since it started or
+   * since the last ResetProfile().
+   */
+  struct Profile {
+    /**
+     * \return A single line summary, such as
+     *         "[dvl_reader] tid 4242: cpu 3.1% (31 ms in 1000 ms), context
+     *         switches 998 voluntary 2 involuntary, 1000 loops mean 1000 us
+     *         p50 1048 us p99 1048 us max 1350 us".
+     */
+    std::string ToString() const;
+
+    /**
+     * The name of the thread from the ThreadOptions, may be empty.
+     */
+    std::string name;
+
+    pid_t tid;
+
+    Clock::duration elapsed;
+
+    /**
+     * The time the thread spent on a core, user and system.
+     */
+    Clock::duration cpu_time;
+
+    /**
+     * cpu_time over elapsed, 1 for a thread that never sleeps.
+     */
+    double cpu_usage;
+
+    /**
+     * The times the thread blocked, on a sleep or an I/O.
+     */
+    uint64_t voluntary_switches;
+
+    /**
+     * The times the thread was preempted, a sign of an oversubscribed core.
+     */
+    uint64_t involuntary_switches;
+
+    /**
+     * The loop times are the times between two Heartbeat() calls.
+     */
+    uint64_t loops;
+
+    Clock::duration mean_loop_time;
+
+    /**
+     * The percentiles are rounded up to the end of their bucket in the
+     * LatencyHistogram, at most 1 / 32 above the exact value.
+     */
+    Clock::duration p50_loop_time;
+
+    Clock::duration p99_loop_time;
+
+    Clock::duration max_loop_time;
+  };
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
   Runnable() ATLAS_NOEXCEPT;
 
+  /**
+   * Create a Runnable whose thread will be configured with the given options
+   * -- affinity, scheduling policy and name -- before Run() is called.
+   */
+  explicit Runnable(const ThreadOptions &options) ATLAS_NOEXCEPT;
+
   virtual ~Runnable() ATLAS_NOEXCEPT;
 
   /**
@@ -81,6 +157,9 @@ class Runnable {
    * Start the parrallel task of this Runnable instance.
    *
    * This will create a new thread with the Runnable.run() method.
+   * The thread options are applied by the new thread before Run() is called.
+   * If they cannot be applied, the thread is joined without calling Run() and
+   * the std::system_error is rethrown here.
    */
   void Start();
 
@@ -91,6 +170,9 @@ class Runnable {
    * Thus, a derived class that implement the Runnable interface and provid
    * a looping parallel task must check for the stop_ member state, otherwise,
    * the stop() call will be blocking forever.
+   *
+   * The waits in WaitFor() and WaitUntil() return right away, and the stop
+   * event becomes readable to wake the thread blocked on a file descriptor.
    */
   void Stop() ATLAS_NOEXCEPT_(false);
 
@@ -103,6 +185,47 @@ class Runnable {
    */
   bool IsRunning() const ATLAS_NOEXCEPT;
 
+  /**
+   * Change the options of the thread. They are used on the next Start().
+   */
+  void SetThreadOptions(const ThreadOptions &options);
+
+  const ThreadOptions &GetThreadOptions() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of Heartbeat() calls, for a Supervisor to check that
+   *         the loop of Run() makes progress.
+   */
+  uint64_t GetHeartbeatCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * Start collecting the loop times in Heartbeat(). The CPU time and the
+   * context switches are counted from now, or from the next Start().
+   *
+   * Profiling is off by default. Once on, each Heartbeat() also reads the
+   * Clock and records the loop time, a few tens of nanoseconds.
+   */
+  void EnableProfiling();
+
+  void DisableProfiling() ATLAS_NOEXCEPT;
+
+  bool IsProfiling() const ATLAS_NOEXCEPT;
+
+  /**
+   * Sample the CPU time of the thread, with the CPU-time clock of the thread,
+   * and its context switches, from /proc/self/task/<tid>/status.
+   *
+   * Call it from any thread, but not concurrently with Start() or Stop().
+   *
+   * \throw std::logic_error if the Runnable is not running or not profiled.
+   */
+  Profile GetProfile() const;
+
+  /**
+   * Restart the profile from now.
+   */
+  void ResetProfile();
+
  protected:
   //============================================================================
   // P R O T E C T E D   M E T H O D S
@@ -130,13 +253,98 @@ class Runnable {
    */
   bool MustStop() const ATLAS_NOEXCEPT;
 
+  /**
+   * Sleep for the given duration, unless Stop() is called in the meantime.
+   *
+   * Use it rather than std::this_thread::sleep_for() in Run(), so the thread
+   * does not wait out its whole sleep before it notices the stop.
+   *
+   * \return false if the Runnable must stop, true once the duration elapsed.
+   */
+  template <class Rep_, class Period_>
+  bool WaitFor(const std::chrono::duration<Rep_, Period_> &duration);
+
+  /**
+   * Sleep until the given time, unless Stop() is called in the meantime.
+   *
+   * \return false if the Runnable must stop, true once the time is reached.
+   */
+  template <class Clock_, class Duration_>
+  bool WaitUntil(const std::chrono::time_point<Clock_, Duration_> &time);
+
+  /**
+   * A file descriptor that becomes readable when Stop() is called, to add to
+   * the ones a Run() blocks on with select() or poll(), such as
+   * Serial::WaitReadable(int). It must not be read nor closed.
+   *
+   * \return The eventfd, or -1 if it could not be created.
+   */
+  int GetStopEvent() const ATLAS_NOEXCEPT;
+
+  /**
+   * Signal that the loop of Run() makes progress. Call it once per iteration
+   * when the Runnable is watched by a Supervisor. It is a relaxed increment,
+   * cheap enough for a loop at several kHz.
+   */
+  void Heartbeat() ATLAS_NOEXCEPT;
+
  private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct ThreadSample {
+    Clock::time_point time;
+
+    Clock::duration cpu_time;
+
+    uint64_t voluntary_switches;
+
+    uint64_t involuntary_switches;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Read the counters of the thread, whose kernel id is tid.
+   */
+  static ThreadSample SampleThread(pthread_t thread, pid_t tid);
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
   std::unique_ptr<std::thread> thread_;
 
   std::atomic<bool> stop_;
+
+  ThreadOptions options_;
+
+  std::mutex wait_mutex_;
+
+  std::condition_variable wait_condition_;
+
+  int stop_event_;
+
+  std::atomic<uint64_t> heartbeats_;
+
+  std::atomic<bool> profiling_;
+
+  /**
+   * The time of the last Heartbeat(), in ticks of the Clock, or 0.
+   */
+  std::atomic<Clock::rep> last_heartbeat_;
+
+  /**
+   * Allocated by the first EnableProfiling(), so the Runnables that are
+   * never profiled do not carry the 15 kB of the histogram.
+   */
+  std::unique_ptr<LatencyHistogram> loop_times_;
+
+  pid_t tid_;
+
+  mutable std::mutex profile_mutex_;
+
+  ThreadSample profile_start_;
 };
 
 }  // namespace sonia_common
@@ -27,6 +27,18 @@
 #error This file may only be included from runnable.h
 #endif
 
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
 namespace sonia_common {
 
 //==============================================================================
@@ -34,8 +46,33 @@ namespace sonia_common {
 
 //------------------------------------------------------------------------------
 //
-ATLAS_ALWAYS_INLINE Runnable::Runnable() ATLAS_NOEXCEPT : thread_(nullptr),
-                                                          stop_(false) {}
+ATLAS_ALWAYS_INLINE Runnable::Runnable() ATLAS_NOEXCEPT
+    : thread_(nullptr),
+      stop_(false),
+      options_(),
+      stop_event_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+      heartbeats_(0),
+      profiling_(false),
+      last_heartbeat_(0),
+      loop_times_(),
+      tid_(0),
+      profile_mutex_(),
+      profile_start_() {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Runnable::Runnable(const ThreadOptions &options)
+    ATLAS_NOEXCEPT : thread_(nullptr),
+                     stop_(false),
+                     options_(options),
+                     stop_event_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+                     heartbeats_(0),
+                     profiling_(false),
+                     last_heartbeat_(0),
+                     loop_times_(),
+                     tid_(0),
+                     profile_mutex_(),
+                     profile_start_() {}
 
 //------------------------------------------------------------------------------
 //
@@ -43,6 +80,9 @@ ATLAS_ALWAYS_INLINE Runnable::~Runnable() ATLAS_NOEXCEPT {
   if (IsRunning()) {
     Stop();
   }
+  if (stop_event_ != -1) {
+    close(stop_event_);
+  }
 }
 
 //==============================================================================
@@ -51,19 +91,64 @@ ATLAS_ALWAYS_INLINE Runnable::~Runnable() ATLAS_NOEXCEPT {
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE void Runnable::Start() {
-  if (thread_ == nullptr) {
-    thread_ =
-        std::unique_ptr<std::thread>(new std::thread(&Runnable::Run, this));
-  } else {
+  if (thread_ != nullptr) {
     throw std::logic_error("The thread must be stoped before it is started.");
   }
+
+  // Rearm after a previous Stop(), so the Runnable can be restarted.
+  stop_ = false;
+  if (stop_event_ != -1) {
+    uint64_t count;
+    ssize_t read_size = read(stop_event_, &count, sizeof(count));
+    (void)read_size;
+  }
+
+  std::promise<void> configured;
+  auto result = configured.get_future();
+  thread_ = std::unique_ptr<std::thread>(new std::thread([this, &configured] {
+    try {
+      ApplyThreadOptions(options_);
+    } catch (...) {
+      configured.set_exception(std::current_exception());
+      return;
+    }
+    tid_ = static_cast<pid_t>(syscall(SYS_gettid));
+    if (profiling_) {
+      std::lock_guard<std::mutex> lock(profile_mutex_);
+      profile_start_ = SampleThread(pthread_self(), tid_);
+      last_heartbeat_ = 0;
+      loop_times_->Reset();
+    }
+    configured.set_value();
+    Run();
+  }));
+
+  try {
+    result.get();
+  } catch (...) {
+    thread_->join();
+    thread_ = nullptr;
+    throw;
+  }
 }
 
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE void Runnable::Stop() ATLAS_NOEXCEPT_(false) {
   if (IsRunning()) {
-    stop_ = true;
+    {
+      // Under the lock, so a WaitUntil() cannot miss the notification between
+      // its check of stop_ and its wait.
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      stop_ = true;
+    }
+    wait_condition_.notify_all();
+    if (stop_event_ != -1) {
+      const uint64_t one = 1;
+      // Cannot fail but on an overflow of the counter, which stays readable.
+      ssize_t written = write(stop_event_, &one, sizeof(one));
+      (void)written;
+    }
     thread_->join();
     thread_ = nullptr;
   } else {
@@ -77,10 +162,212 @@ ATLAS_ALWAYS_INLINE bool Runnable::IsRunning() const ATLAS_NOEXCEPT {
   return thread_ != nullptr && thread_->joinable() && !MustStop();
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void Runnable::SetThreadOptions(
+    const ThreadOptions &options) {
+  options_ = options;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE const ThreadOptions &Runnable::GetThreadOptions() const
+    ATLAS_NOEXCEPT {
+  return options_;
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE bool Runnable::MustStop() const ATLAS_NOEXCEPT {
   return stop_;
 }
 
+//------------------------------------------------------------------------------
+//
+template <class Rep_, class Period_>
+ATLAS_ALWAYS_INLINE bool Runnable::WaitFor(
+    const std::chrono::duration<Rep_, Period_> &duration) {
+  return WaitUntil(std::chrono::steady_clock::now() + duration);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Clock_, class Duration_>
+ATLAS_ALWAYS_INLINE bool Runnable::WaitUntil(
+    const std::chrono::time_point<Clock_, Duration_> &time) {
+  std::unique_lock<std::mutex> lock(wait_mutex_);
+  return !wait_condition_.wait_until(lock, time,
+                                     [this] { return MustStop(); });
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE int Runnable::GetStopEvent() const ATLAS_NOEXCEPT {
+  return stop_event_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void Runnable::Heartbeat() ATLAS_NOEXCEPT {
+  heartbeats_.fetch_add(1, std::memory_order_relaxed);
+  // Acquire, so the histogram allocated by EnableProfiling() is visible.
+  if (profiling_.load(std::memory_order_acquire)) {
+    const Clock::rep now = Clock::now().time_since_epoch().count();
+    const Clock::rep last =
+        last_heartbeat_.exchange(now, std::memory_order_relaxed);
+    if (last != 0 && now > last) {
+      loop_times_->Record(Clock::duration(now - last));
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE uint64_t Runnable::GetHeartbeatCount() const
+    ATLAS_NOEXCEPT {
+  return heartbeats_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Runnable::EnableProfiling() {
+  {
+    std::lock_guard<std::mutex> lock(profile_mutex_);
+    if (!loop_times_) {
+      loop_times_.reset(new LatencyHistogram());
+    }
+  }
+  if (!profiling_.exchange(true) && IsRunning()) {
+    ResetProfile();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Runnable::DisableProfiling() ATLAS_NOEXCEPT {
+  profiling_ = false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Runnable::IsProfiling() const ATLAS_NOEXCEPT {
+  return profiling_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Runnable::Profile Runnable::GetProfile() const {
+  if (!IsRunning()) {
+    throw std::logic_error("The thread is not running.");
+  }
+  if (!IsProfiling()) {
+    throw std::logic_error("The thread is not profiled.");
+  }
+
+  std::lock_guard<std::mutex> lock(profile_mutex_);
+  const ThreadSample now = SampleThread(thread_->native_handle(), tid_);
+
+  Profile profile;
+  profile.name = options_.name;
+  profile.tid = tid_;
+  profile.elapsed = now.time - profile_start_.time;
+  profile.cpu_time = now.cpu_time - profile_start_.cpu_time;
+  profile.cpu_usage =
+      profile.elapsed.count() <= 0
+          ? 0.0
+          : static_cast<double>(profile.cpu_time.count()) /
+                static_cast<double>(profile.elapsed.count());
+  profile.voluntary_switches =
+      now.voluntary_switches - profile_start_.voluntary_switches;
+  profile.involuntary_switches =
+      now.involuntary_switches - profile_start_.involuntary_switches;
+
+  const LatencyHistogram::Snapshot loops = loop_times_->GetSnapshot();
+  profile.loops = loops.count;
+  profile.mean_loop_time = loops.Mean();
+  profile.p50_loop_time = loops.Percentile(0.5);
+  profile.p99_loop_time = loops.Percentile(0.99);
+  profile.max_loop_time = loops.max;
+  return profile;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Runnable::ResetProfile() {
+  if (!IsRunning()) {
+    throw std::logic_error("The thread is not running.");
+  }
+  std::lock_guard<std::mutex> lock(profile_mutex_);
+  profile_start_ = SampleThread(thread_->native_handle(), tid_);
+  last_heartbeat_ = 0;
+  if (loop_times_) {
+    loop_times_->Reset();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Runnable::ThreadSample Runnable::SampleThread(pthread_t thread,
+                                                           pid_t tid) {
+  ThreadSample sample;
+  sample.time = Clock::now();
+
+  clockid_t clock;
+  int error = pthread_getcpuclockid(thread, &clock);
+  if (error != 0) {
+    throw std::system_error(error, std::system_category(),
+                            "pthread_getcpuclockid");
+  }
+  timespec cpu_time;
+  if (clock_gettime(clock, &cpu_time) != 0) {
+    throw std::system_error(errno, std::system_category(), "clock_gettime");
+  }
+  sample.cpu_time = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::seconds(cpu_time.tv_sec) +
+      std::chrono::nanoseconds(cpu_time.tv_nsec));
+
+  sample.voluntary_switches = 0;
+  sample.involuntary_switches = 0;
+  std::ifstream status("/proc/self/task/" + std::to_string(tid) + "/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    std::istringstream fields(line);
+    std::string key;
+    uint64_t value = 0;
+    fields >> key >> value;
+    if (key == "voluntary_ctxt_switches:") {
+      sample.voluntary_switches = value;
+    } else if (key == "nonvoluntary_ctxt_switches:") {
+      sample.involuntary_switches = value;
+    }
+  }
+  return sample;
+}
+
+//==============================================================================
+// F U N C T I O N S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::string Runnable::Profile::ToString() const {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::milliseconds;
+
+  std::ostringstream line;
+  line.setf(std::ios::fixed);
+  line.precision(1);
+  line << "[" << (name.empty() ? "runnable" : name) << "] tid " << tid
+       << ": cpu " << cpu_usage * 100.0 << "% ("
+       << duration_cast<milliseconds>(cpu_time).count() << " ms in "
+       << duration_cast<milliseconds>(elapsed).count()
+       << " ms), context switches " << voluntary_switches << " voluntary "
+       << involuntary_switches << " involuntary, " << loops << " loops mean "
+       << duration_cast<microseconds>(mean_loop_time).count() << " us p50 "
+       << duration_cast<microseconds>(p50_loop_time).count() << " us p99 "
+       << duration_cast<microseconds>(p99_loop_time).count() << " us max "
+       << duration_cast<microseconds>(max_loop_time).count() << " us";
+  return line.str();
+}
+
 }  // namespace sonia_common
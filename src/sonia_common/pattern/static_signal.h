@@ -0,0 +1,251 @@
+/**
+ * \file	static_signal.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_STATIC_SIGNAL_H_
+#define SONIA_COMMON_PATTERN_STATIC_SIGNAL_H_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/subject.h>
+
+namespace sonia_common {
+
+template <typename Signature_>
+class Delegate;
+
+/**
+ * A callable stored inline, without allocation nor virtual call.
+ *
+ * The delegate holds a copy of a small trivially copyable callable, such as
+ * a lambda capturing a few pointers, and calls it through a function pointer
+ * generated for its type, in which the callable itself is inlined.
+ */
+template <typename... Args_>
+class Delegate<void(Args_...)> {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Create an empty delegate.
+   */
+  Delegate() ATLAS_NOEXCEPT;
+
+  /**
+   * Copy the callable in the delegate.
+   *
+   * The callable must be trivially copyable and hold in three pointers.
+   */
+  template <class Fp_>
+  explicit Delegate(const Fp_ &f) ATLAS_NOEXCEPT;
+
+  /**
+   * Call the method on the object, which must outlive the delegate.
+   */
+  template <class Tp_>
+  Delegate(Tp_ &object, void (Tp_::*method)(Args_...)) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  void operator()(typename details::NotifyParameter<Args_>::type... args) const;
+
+  explicit operator bool() const ATLAS_NOEXCEPT;
+
+ private:
+  //==========================================================================
+  // P R I V A T E   T Y P E S
+
+  using Trampoline = void (*)(const void *,
+                              typename details::NotifyParameter<Args_>::type...);
+
+  enum : size_t { kStorageSize = 3 * sizeof(void *) };
+
+  using Storage =
+      typename std::aligned_storage<kStorageSize, alignof(void *)>::type;
+
+  template <class Tp_>
+  struct MethodCall {
+    Tp_ *object;
+    void (Tp_::*method)(Args_...);
+
+    void operator()(
+        typename details::NotifyParameter<Args_>::type... args) const {
+      (object->*method)(args...);
+    }
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  template <class Fp_>
+  static void Call(const void *storage,
+                   typename details::NotifyParameter<Args_>::type... args);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  Storage storage_;
+
+  Trampoline trampoline_;
+};
+
+/**
+ * A signal with a fixed number of slots held inline.
+ *
+ * This is the counterpart of a Subject for the hot loops, such as the sensor
+ * fusion: connecting a slot never allocates and a notification calls each
+ * slot through a Delegate, without the virtual call of
+ * Observer::OnSubjectNotify() nor any lock or atomic operation.
+ *
+ * In exchange, the signal is not thread safe: connect the slots while
+ * setting up, before notifying, or from the notifying thread.
+ *
+ * Sample usage:
+ *
+ * InlineSignal<4, const ImuSample &> imu_signal;
+ * imu_signal.Connect(ekf, &Ekf::OnImu);
+ * imu_signal.Connect([&](const ImuSample &sample) { logger.Log(sample); });
+ * imu_signal.Notify(sample);
+ */
+template <size_t Capacity_, typename... Args_>
+class InlineSignal {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Slot = Delegate<void(Args_...)>;
+
+  using SlotId = size_t;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  InlineSignal() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * Connect a callable, see Delegate for the requirements.
+   *
+   * \return The identifier to give to Disconnect().
+   * \throw std::length_error if every slot is used.
+   */
+  template <class Fp_>
+  SlotId Connect(const Fp_ &f);
+
+  template <class Tp_>
+  SlotId Connect(Tp_ &object, void (Tp_::*method)(Args_...));
+
+  /**
+   * \throw std::out_of_range if no slot is connected with this identifier.
+   */
+  void Disconnect(SlotId id);
+
+  /**
+   * Call every connected slot, in the order of their identifiers.
+   */
+  void Notify(typename details::NotifyParameter<Args_>::type... args) const;
+
+  size_t SlotCount() const ATLAS_NOEXCEPT;
+
+  static constexpr size_t Capacity() ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  SlotId Add(const Slot &slot);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::array<Slot, Capacity_> slots_;
+
+  /**
+   * One past the last used slot, the empty ones before are skipped.
+   */
+  size_t end_;
+
+  size_t count_;
+};
+
+/**
+ * A signal whose slots are fixed at compile time.
+ *
+ * The slots are stored by value and called directly, so the compiler can
+ * inline the whole notification. Create it with MakeStaticSignal().
+ *
+ * Sample usage:
+ *
+ * auto signal = MakeStaticSignal(
+ *     [&](const ImuSample &sample) { ekf.OnImu(sample); },
+ *     [&](const ImuSample &sample) { logger.Log(sample); });
+ * signal.Notify(sample);
+ */
+template <class... Slots_>
+class StaticSignal {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit StaticSignal(const Slots_ &... slots);
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * Call every slot, in order, with the arguments.
+   */
+  template <class... Args_>
+  void Notify(const Args_ &... args) const;
+
+  static constexpr size_t SlotCount() ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::tuple<Slots_...> slots_;
+};
+
+//==============================================================================
+// F U N C T I O N S   S E C T I O N
+
+template <class... Slots_>
+StaticSignal<typename std::decay<Slots_>::type...> MakeStaticSignal(
+    Slots_ &&... slots);
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/static_signal_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_STATIC_SIGNAL_H_
@@ -0,0 +1,238 @@
+/**
+ * \file	static_signal_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_STATIC_SIGNAL_H_
+#error This file may only be included from static_signal.h
+#endif
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include <sonia_common/pattern/details/apply.h>
+
+namespace sonia_common {
+
+namespace details {
+
+template <class Tuple_, class... Args_, size_t... Indexes_>
+ATLAS_ALWAYS_INLINE void CallEach(const Tuple_ &slots,
+                                  IndexSequence<Indexes_...>,
+                                  const Args_ &... args) {
+  // Expands to one call per slot, in order.
+  const int calls[] = {0, (std::get<Indexes_>(slots)(args...), 0)...};
+  (void)calls;
+}
+
+}  // namespace details
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE Delegate<void(Args_...)>::Delegate() ATLAS_NOEXCEPT
+    : storage_(),
+      trampoline_(nullptr) {}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+template <class Fp_>
+ATLAS_INLINE Delegate<void(Args_...)>::Delegate(const Fp_ &f) ATLAS_NOEXCEPT
+    : storage_(),
+      trampoline_(&Delegate<void(Args_...)>::Call<Fp_>) {
+  static_assert(std::is_trivially_copyable<Fp_>::value,
+                "The callable of a Delegate must be trivially copyable");
+  static_assert(sizeof(Fp_) <= kStorageSize &&
+                    alignof(Fp_) <= alignof(Storage),
+                "The callable is too large for a Delegate");
+  new (&storage_) Fp_(f);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+template <class Tp_>
+ATLAS_INLINE Delegate<void(Args_...)>::Delegate(
+    Tp_ &object, void (Tp_::*method)(Args_...)) ATLAS_NOEXCEPT
+    : Delegate(MethodCall<Tp_>{&object, method}) {}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Capacity_, typename... Args_>
+ATLAS_INLINE InlineSignal<Capacity_, Args_...>::InlineSignal() ATLAS_NOEXCEPT
+    : slots_(),
+      end_(0),
+      count_(0) {}
+
+//------------------------------------------------------------------------------
+//
+template <class... Slots_>
+ATLAS_INLINE StaticSignal<Slots_...>::StaticSignal(const Slots_ &... slots)
+    : slots_(slots...) {}
+
+//==============================================================================
+// O P E R A T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void Delegate<void(Args_...)>::operator()(
+    typename details::NotifyParameter<Args_>::type... args) const {
+  trampoline_(&storage_, args...);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE Delegate<void(Args_...)>::operator bool() const
+    ATLAS_NOEXCEPT {
+  return trampoline_ != nullptr;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+template <class Fp_>
+ATLAS_INLINE void Delegate<void(Args_...)>::Call(
+    const void *storage,
+    typename details::NotifyParameter<Args_>::type... args) {
+  (*static_cast<const Fp_ *>(storage))(args...);
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Capacity_, typename... Args_>
+template <class Fp_>
+ATLAS_INLINE typename InlineSignal<Capacity_, Args_...>::SlotId
+InlineSignal<Capacity_, Args_...>::Connect(const Fp_ &f) {
+  return Add(Slot(f));
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Capacity_, typename... Args_>
+template <class Tp_>
+ATLAS_INLINE typename InlineSignal<Capacity_, Args_...>::SlotId
+InlineSignal<Capacity_, Args_...>::Connect(Tp_ &object,
+                                           void (Tp_::*method)(Args_...)) {
+  return Add(Slot(object, method));
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Capacity_, typename... Args_>
+ATLAS_INLINE void InlineSignal<Capacity_, Args_...>::Disconnect(SlotId id) {
+  if (id >= end_ || !slots_[id]) {
+    throw std::out_of_range("No slot is connected with this identifier");
+  }
+  slots_[id] = Slot();
+  --count_;
+  while (end_ > 0 && !slots_[end_ - 1]) {
+    --end_;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Capacity_, typename... Args_>
+ATLAS_ALWAYS_INLINE void InlineSignal<Capacity_, Args_...>::Notify(
+    typename details::NotifyParameter<Args_>::type... args) const {
+  for (size_t i = 0; i < end_; ++i) {
+    if (slots_[i]) {
+      slots_[i](args...);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Capacity_, typename... Args_>
+ATLAS_INLINE size_t InlineSignal<Capacity_, Args_...>::SlotCount() const
+    ATLAS_NOEXCEPT {
+  return count_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Capacity_, typename... Args_>
+ATLAS_INLINE constexpr size_t InlineSignal<Capacity_, Args_...>::Capacity()
+    ATLAS_NOEXCEPT {
+  return Capacity_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <size_t Capacity_, typename... Args_>
+ATLAS_INLINE typename InlineSignal<Capacity_, Args_...>::SlotId
+InlineSignal<Capacity_, Args_...>::Add(const Slot &slot) {
+  for (size_t i = 0; i < Capacity_; ++i) {
+    if (!slots_[i]) {
+      slots_[i] = slot;
+      ++count_;
+      end_ = std::max(end_, i + 1);
+      return i;
+    }
+  }
+  throw std::length_error("Every slot of the signal is used");
+}
+
+//------------------------------------------------------------------------------
+//
+template <class... Slots_>
+template <class... Args_>
+ATLAS_ALWAYS_INLINE void StaticSignal<Slots_...>::Notify(
+    const Args_ &... args) const {
+  details::CallEach(slots_,
+                    typename details::MakeIndexSequence<sizeof...(Slots_)>::type(),
+                    args...);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class... Slots_>
+ATLAS_INLINE constexpr size_t StaticSignal<Slots_...>::SlotCount()
+    ATLAS_NOEXCEPT {
+  return sizeof...(Slots_);
+}
+
+//==============================================================================
+// F U N C T I O N S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class... Slots_>
+ATLAS_INLINE StaticSignal<typename std::decay<Slots_>::type...>
+MakeStaticSignal(Slots_ &&... slots) {
+  return StaticSignal<typename std::decay<Slots_>::type...>(slots...);
+}
+
+}  // namespace sonia_common
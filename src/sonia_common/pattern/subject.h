@@ -25,17 +25,43 @@
 #ifndef SONIA_COMMON_PATTERN_SUBJECT_H_
 #define SONIA_COMMON_PATTERN_SUBJECT_H_
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <sonia_common/macros.h>
+#include <sonia_common/sys/latency_histogram.h>
 
 namespace sonia_common {
 
 template <typename... Args_>
 class Observer;
 
+namespace details {
+
+/**
+ * The type of the parameters of Subject::Notify(): a reference argument is
+ * passed as is, a value one by const reference so it is not copied on the
+ * way in.
+ */
+template <typename Tp_>
+struct NotifyParameter {
+  using type = const Tp_ &;
+};
+
+template <typename Tp_>
+struct NotifyParameter<Tp_ &> {
+  using type = Tp_ &;
+};
+
+}  // namespace details
+
 /**
  * A subject is an object that will send notification when is internal state
  * have changed.
@@ -65,6 +91,16 @@ class Observer;
  *   bool must_stop_searching_ = {false};
  * };
  *
+ * The list of observers is copied on write: Notify() iterates over an
+ * immutable snapshot of the list without the observers mutex, while Attach()
+ * and Detach() publish a new version of it. A slow observer thus never blocks
+ * the other notifications, and an observer can detach itself, or attach
+ * other observers, from inside its callback. When Detach() returns, the
+ * observer is not being notified anymore, except by the calling thread.
+ *
+ * The time each observer spends in its callback can be traced, see
+ * EnableTracing(). This tells which observer slows down a pipeline.
+ *
  * \template Args_ A list of arguments to send when a notification is thown.
  * This will usually be the list of the member an observer wants to access --
  * e.g. A reference to an image if the subject is an image provider
@@ -83,6 +119,50 @@ class Subject {
 
   using Ptr = std::shared_ptr<Subject<Args_...>>;
 
+  using Clock = std::chrono::steady_clock;
+
+  struct TracingOptions {
+    TracingOptions();
+
+    /**
+     * The name of the subject in the log lines.
+     */
+    std::string name;
+
+    /**
+     * The time an observer may spend in a callback before being flagged.
+     * Zero for no budget.
+     */
+    Clock::duration budget;
+
+    /**
+     * The period of the log lines, zero for none. A line is written for each
+     * observer by the first Notify() after the period elapsed.
+     */
+    Clock::duration log_period;
+
+    /**
+     * Where the log lines are written, std::clog by default.
+     */
+    std::function<void(const std::string &)> log;
+  };
+
+  /**
+   * The time spent by an observer in its callbacks since the tracing has
+   * been enabled or reset.
+   */
+  struct ObserverTrace : public LatencyHistogram::Snapshot {
+    /**
+     * The name of the observer, see Observer::GetName().
+     */
+    std::string name;
+
+    /**
+     * The number of calls that went over the budget.
+     */
+    uint64_t over_budget;
+  };
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
@@ -104,9 +184,18 @@ class Subject {
    * Throw a notification to all the observers that have attached to this
    * subject.
    *
+   * The observers attached or detached during the notification may or may
+   * not receive it.
+   *
+   * The arguments are forwarded by reference to every observer. Declaring
+   * them as references, e.g. Subject<const cv::Mat &>, or as a SharedSubject
+   * for payloads that outlive the call, thus never copies them. An argument
+   * declared by value is copied once per observer.
+   *
    * \param args The arguments that
    */
-  void Notify(Args_... args) ATLAS_NOEXCEPT;
+  void Notify(typename details::NotifyParameter<Args_>::type... args)
+      ATLAS_NOEXCEPT;
 
   /**
    * Return the number of observers attached to this subject.
@@ -120,6 +209,9 @@ class Subject {
 
   /**
    * Remove an observer from the list. Return false if it was not attached.
+   *
+   * Waits for the notifications of this observer running on other threads
+   * to complete.
    */
   void Detach(Observer<Args_...> &observer);
 
@@ -128,10 +220,98 @@ class Subject {
    */
   void DetachAll() ATLAS_NOEXCEPT;
 
+  /**
+   * Start timing the callback of each observer in Notify(). This costs two
+   * reads of the clock per observer and per notification.
+   *
+   * Enabling it again replaces the options and keeps the traces.
+   */
+  void EnableTracing(const TracingOptions &options = TracingOptions());
+
+  void DisableTracing() ATLAS_NOEXCEPT;
+
+  bool IsTracing() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The traces of the observers attached right now.
+   */
+  std::vector<ObserverTrace> GetTraces() const;
+
+  void ResetTraces() ATLAS_NOEXCEPT;
+
  private:
+  //==========================================================================
+  // P R I V A T E   T Y P E S
+
+  /**
+   * An attached observer. The entry outlives the version of the list it has
+   * been removed from, so the threads still iterating over that version
+   * see it as detached.
+   */
+  struct Entry {
+    explicit Entry(Observer<Args_...> &observer) ATLAS_NOEXCEPT;
+
+    Observer<Args_...> *const observer;
+
+    std::atomic<bool> detached;
+
+    /**
+     * The number of notifications of this observer in progress.
+     */
+    std::atomic<size_t> calls;
+
+    /**
+     * Signaled when a call ends after the entry is detached, for
+     * WaitForCalls() to block on rather than spin.
+     */
+    mutable std::mutex calls_mutex;
+
+    mutable std::condition_variable calls_done;
+
+    /**
+     * Raised once the latency is allocated, which is then kept for the life
+     * of the entry.
+     */
+    std::atomic<bool> traced;
+
+    /**
+     * Allocated when tracing is enabled, so the observers of a subject that
+     * is never traced do not carry the 15 kB of the histogram.
+     */
+    std::unique_ptr<LatencyHistogram> latency;
+
+    std::atomic<uint64_t> over_budget;
+  };
+
+  using EntryList = std::vector<std::shared_ptr<Entry>>;
+
   //============================================================================
   // P R I V A T E   M E T H O D S
 
+  std::shared_ptr<const EntryList> Snapshot() const ATLAS_NOEXCEPT;
+
+  /**
+   * Remove the observer from the list and publish the new version.
+   * The observers_mutex_ must be held.
+   */
+  std::shared_ptr<Entry> Remove(Observer<Args_...> &observer);
+
+  /**
+   * Wait for the other threads to be done notifying the entry.
+   */
+  static void WaitForCalls(const Entry &entry) ATLAS_NOEXCEPT;
+
+  /**
+   * Count a call to the entry as done, and wake WaitForCalls() if the entry
+   * is detached.
+   */
+  static void EndCall(Entry &entry) ATLAS_NOEXCEPT;
+
+  /**
+   * The entries the calling thread is notifying, innermost last.
+   */
+  static std::vector<const Entry *> &CallFrames() ATLAS_NOEXCEPT;
+
   /**
    * Detach an observer without calling a callback.
    *
@@ -146,22 +326,66 @@ class Subject {
    */
   void DetachNoCallback(Observer<Args_...> &observer);
 
+  /**
+   * Allocate the latency of the entry if it has none yet. The
+   * observers_mutex_ must be held.
+   */
+  static void StartTracing(Entry &entry);
+
+  void Trace(Entry &entry, Clock::duration elapsed) ATLAS_NOEXCEPT;
+
+  /**
+   * Write the log lines if the period elapsed. Only one of the notifying
+   * threads writes them.
+   */
+  void LogTracesIfDue() ATLAS_NOEXCEPT;
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
   /**
-   * This list of all the observers that are currently attached to this subject.
+   * The current version of the list of the observers attached to this
+   * subject. It is never modified once published, only replaced, so it is
+   * read and written with the atomic functions of std::shared_ptr.
    */
-  std::vector<Observer<Args_...> *> observers_;
+  std::shared_ptr<const EntryList> observers_;
 
   /**
-   * A mutex that is going to be locked every time we try to access the list
-   * of observers.
-   * This provides thread safety for the all class ressources.
+   * The entries of the attached observers, for a fast lookup.
+   */
+  std::unordered_map<Observer<Args_...> *, std::shared_ptr<Entry>> entries_;
+
+  /**
+   * Serializes the writers of the list. Notify() never takes it.
    */
   mutable std::mutex observers_mutex_;
+
+  std::atomic<bool> tracing_;
+
+  /**
+   * The budget in ticks of the Clock, copied out of the options to be read
+   * by Notify() without locking.
+   */
+  std::atomic<Clock::rep> budget_;
+
+  /**
+   * When the next log lines are due, in ticks since the epoch of the Clock.
+   */
+  std::atomic<Clock::rep> next_log_;
+
+  TracingOptions tracing_options_;
+
+  mutable std::mutex tracing_mutex_;
 };
 
+/**
+ * A subject sending an immutable payload shared with the observers. Notify()
+ * passes the pointer by reference: an observer that keeps the payload after
+ * the call copies the pointer, no observer ever copies the payload itself.
+ */
+template <typename Tp_>
+using SharedSubject = Subject<const std::shared_ptr<const Tp_> &>;
+
 }  // namespace sonia_common
 
 #include <sonia_common/pattern/subject_inl.h>
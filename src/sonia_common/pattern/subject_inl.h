@@ -29,7 +29,11 @@
 
 #include <assert.h>
 #include <sonia_common/pattern/observer.h>
+#include <sonia_common/sys/trace_scope.h>
 #include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
 
 namespace sonia_common {
 
@@ -40,28 +44,62 @@ namespace sonia_common {
 //
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Subject<Args_...>::Subject() ATLAS_NOEXCEPT
-    : observers_(),
-      observers_mutex_() {}
+    : observers_(std::make_shared<const EntryList>()),
+      entries_(),
+      observers_mutex_(),
+      tracing_(false),
+      budget_(0),
+      next_log_(0),
+      tracing_options_(),
+      tracing_mutex_() {}
 
 //------------------------------------------------------------------------------
 //
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Subject<Args_...>::Subject(const Subject<Args_...> &rhs)
-    ATLAS_NOEXCEPT : observers_(),
-                     observers_mutex_() {
-  for (auto &observer : rhs.observers_) {
-    observer->Observe(*this);
+    ATLAS_NOEXCEPT : observers_(std::make_shared<const EntryList>()),
+                     entries_(),
+                     observers_mutex_(),
+                     tracing_(false),
+                     budget_(0),
+                     next_log_(0),
+                     tracing_options_(),
+                     tracing_mutex_() {
+  for (auto &entry : *rhs.Snapshot()) {
+    entry->observer->Observe(*this);
   }
 }
 //------------------------------------------------------------------------------
 //
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE Subject<Args_...>::~Subject() ATLAS_NOEXCEPT {
-  for (const auto &observer : observers_) {
-    observer->OnSubjectDisconnected(*this);
+  for (const auto &entry : *Snapshot()) {
+    entry->observer->OnSubjectDisconnected(*this);
   }
 }
 
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE Subject<Args_...>::Entry::Entry(
+    Observer<Args_...> &observer) ATLAS_NOEXCEPT : observer(&observer),
+                                                   detached(false),
+                                                   calls(0),
+                                                   calls_mutex(),
+                                                   calls_done(),
+                                                   traced(false),
+                                                   latency(),
+                                                   over_budget(0) {}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE Subject<Args_...>::TracingOptions::TracingOptions()
+    : name("subject"),
+      budget(Clock::duration::zero()),
+      log_period(Clock::duration::zero()),
+      log([](const std::string &line) { std::clog << line << std::endl; }) {}
+
 //==============================================================================
 // O P E R A T O R S   S E C T I O N
 
@@ -71,8 +109,8 @@ template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::operator=(
     const Subject<Args_...> &rhs) ATLAS_NOEXCEPT {
   DetachAll();
-  for (auto &observer : rhs.observers_) {
-    Attach(*observer);
+  for (auto &entry : *rhs.Snapshot()) {
+    Attach(*entry->observer);
   }
 }
 
@@ -86,12 +124,17 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::Attach(
     Observer<Args_...> &observer) {
   std::unique_lock<std::mutex> locker(observers_mutex_);
 
-  auto it = std::find(observers_.begin(), observers_.end(), &observer);
-  if (it != observers_.end()) {
+  auto entry = std::make_shared<Entry>(observer);
+  if (tracing_) {
+    StartTracing(*entry);
+  }
+  if (!entries_.emplace(&observer, entry).second) {
     throw std::invalid_argument("The element is already in the container.");
-  } else {
-    observers_.push_back(&observer);
   }
+  auto observers = std::make_shared<EntryList>(*observers_);
+  observers->push_back(entry);
+  std::atomic_store(&observers_,
+                    std::shared_ptr<const EntryList>(std::move(observers)));
   observer.OnSubjectConnected(*this);
 }
 
@@ -100,13 +143,7 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::Attach(
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::Detach(
     Observer<Args_...> &observer) {
-  std::unique_lock<std::mutex> locker(observers_mutex_);
-  auto it = std::find(observers_.begin(), observers_.end(), &observer);
-  if (it == observers_.end()) {
-    throw std::invalid_argument("The element is not in the container.");
-  } else {
-    observers_.erase(it);
-  }
+  DetachNoCallback(observer);
   observer.OnSubjectDisconnected(*this);
 }
 
@@ -115,32 +152,56 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::Detach(
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::DetachNoCallback(
     Observer<Args_...> &observer) {
-  std::unique_lock<std::mutex> locker(observers_mutex_);
-  auto it = std::find(observers_.begin(), observers_.end(), &observer);
-  if (it == observers_.end()) {
-    throw std::invalid_argument("The element is not in the container.");
-  } else {
-    observers_.erase(it);
+  std::shared_ptr<Entry> entry;
+  {
+    std::unique_lock<std::mutex> locker(observers_mutex_);
+    entry = Remove(observer);
   }
+  WaitForCalls(*entry);
 }
 
 //------------------------------------------------------------------------------
 //
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE void Subject<Args_...>::DetachAll() ATLAS_NOEXCEPT {
-  for (const auto &observer : observers_) {
-    Detach(*observer);
+  for (const auto &entry : *Snapshot()) {
+    try {
+      Detach(*entry->observer);
+    } catch (const std::invalid_argument &) {
+      // Already detached by another thread.
+    }
   }
 }
 
 //------------------------------------------------------------------------------
 //
 template <typename... Args_>
-ATLAS_ALWAYS_INLINE void Subject<Args_...>::Notify(Args_... args)
-    ATLAS_NOEXCEPT {
-  std::unique_lock<std::mutex> locker(observers_mutex_);
-  for (const auto &observer : observers_) {
-    observer->OnSubjectNotify(*this, args...);
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::Notify(
+    typename details::NotifyParameter<Args_>::type... args) ATLAS_NOEXCEPT {
+  SONIA_TRACE_SCOPE("subject.notify");
+  auto observers = Snapshot();
+  auto &frames = CallFrames();
+  for (const auto &entry : *observers) {
+    // Detach() raises the flag before waiting on the counter, so either it
+    // waits for this call or the call sees the flag.
+    entry->calls.fetch_add(1);
+    if (!entry->detached.load()) {
+      frames.push_back(entry.get());
+      if (tracing_.load(std::memory_order_relaxed) &&
+          entry->traced.load(std::memory_order_acquire)) {
+        const auto start = Clock::now();
+        entry->observer->OnSubjectNotify(*this, args...);
+        Trace(*entry, Clock::now() - start);
+      } else {
+        entry->observer->OnSubjectNotify(*this, args...);
+      }
+      frames.pop_back();
+    }
+    EndCall(*entry);
+  }
+
+  if (tracing_.load(std::memory_order_relaxed)) {
+    LogTracesIfDue();
   }
 }
 
@@ -149,8 +210,219 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::Notify(Args_... args)
 template <typename... Args_>
 ATLAS_ALWAYS_INLINE size_t
 Subject<Args_...>::ObserverCount() const ATLAS_NOEXCEPT {
-  std::unique_lock<std::mutex> locker(observers_mutex_);
-  return observers_.size();
+  return Snapshot()->size();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE std::shared_ptr<const typename Subject<Args_...>::EntryList>
+Subject<Args_...>::Snapshot() const ATLAS_NOEXCEPT {
+  return std::atomic_load(&observers_);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE std::shared_ptr<typename Subject<Args_...>::Entry>
+Subject<Args_...>::Remove(Observer<Args_...> &observer) {
+  auto it = entries_.find(&observer);
+  if (it == entries_.end()) {
+    throw std::invalid_argument("The element is not in the container.");
+  }
+  auto entry = it->second;
+  entries_.erase(it);
+
+  auto observers = std::make_shared<EntryList>();
+  observers->reserve(observers_->size() - 1);
+  for (const auto &other : *observers_) {
+    if (other != entry) {
+      observers->push_back(other);
+    }
+  }
+  std::atomic_store(&observers_,
+                    std::shared_ptr<const EntryList>(std::move(observers)));
+  entry->detached.store(true);
+  return entry;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::WaitForCalls(const Entry &entry)
+    ATLAS_NOEXCEPT {
+  // The calls made by this thread, e.g. an observer detaching itself from
+  // its callback, cannot complete before we return.
+  const auto &frames = CallFrames();
+  const size_t own_calls =
+      static_cast<size_t>(std::count(frames.begin(), frames.end(), &entry));
+  // A callback may run for a while, e.g. an image filter: block rather than
+  // spin. EndCall() signals under the mutex once the flag is raised.
+  std::unique_lock<std::mutex> lock(entry.calls_mutex);
+  entry.calls_done.wait(lock,
+                        [&] { return entry.calls.load() <= own_calls; });
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::EndCall(Entry &entry)
+    ATLAS_NOEXCEPT {
+  entry.calls.fetch_sub(1);
+  // Detach() raises the flag before waiting: either it sees the decrement,
+  // or this sees the flag.
+  if (entry.detached.load()) {
+    std::lock_guard<std::mutex> lock(entry.calls_mutex);
+    entry.calls_done.notify_all();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE std::vector<const typename Subject<Args_...>::Entry *>
+    &Subject<Args_...>::CallFrames() ATLAS_NOEXCEPT {
+  static thread_local std::vector<const Entry *> frames;
+  return frames;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Subject<Args_...>::EnableTracing(
+    const TracingOptions &options) {
+  {
+    std::lock_guard<std::mutex> guard(tracing_mutex_);
+    tracing_options_ = options;
+  }
+  budget_ = options.budget.count();
+  next_log_ = (Clock::now() + options.log_period).time_since_epoch().count();
+
+  // Under the lock, so Attach() either sees the flag or its entry is here.
+  std::lock_guard<std::mutex> locker(observers_mutex_);
+  for (const auto &entry : entries_) {
+    StartTracing(*entry.second);
+  }
+  tracing_ = true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Subject<Args_...>::DisableTracing() ATLAS_NOEXCEPT {
+  tracing_ = false;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE bool Subject<Args_...>::IsTracing() const ATLAS_NOEXCEPT {
+  return tracing_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE std::vector<typename Subject<Args_...>::ObserverTrace>
+Subject<Args_...>::GetTraces() const {
+  std::vector<ObserverTrace> traces;
+  for (const auto &entry : *Snapshot()) {
+    // Count as a call, like Notify(), so a concurrent Detach() waits before
+    // the observer can be destroyed.
+    entry->calls.fetch_add(1);
+    if (entry->detached.load()) {
+      EndCall(*entry);
+      continue;
+    }
+    ObserverTrace trace;
+    try {
+      trace.name = entry->observer->GetName();
+    } catch (...) {
+      EndCall(*entry);
+      throw;
+    }
+    EndCall(*entry);
+
+    if (entry->traced.load(std::memory_order_acquire)) {
+      static_cast<LatencyHistogram::Snapshot &>(trace) =
+          entry->latency->GetSnapshot();
+    }
+    trace.over_budget = entry->over_budget;
+    traces.push_back(std::move(trace));
+  }
+  return traces;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Subject<Args_...>::ResetTraces() ATLAS_NOEXCEPT {
+  for (const auto &entry : *Snapshot()) {
+    if (entry->traced.load(std::memory_order_acquire)) {
+      entry->latency->Reset();
+    }
+    entry->over_budget = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Subject<Args_...>::StartTracing(Entry &entry) {
+  if (!entry.traced.load(std::memory_order_relaxed)) {
+    entry.latency.reset(new LatencyHistogram());
+    entry.traced.store(true, std::memory_order_release);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::Trace(
+    Entry &entry, Clock::duration elapsed) ATLAS_NOEXCEPT {
+  entry.latency->Record(elapsed);
+  const Clock::rep budget = budget_.load(std::memory_order_relaxed);
+  if (budget > 0 && elapsed.count() > budget) {
+    entry.over_budget.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_INLINE void Subject<Args_...>::LogTracesIfDue() ATLAS_NOEXCEPT {
+  const Clock::rep now = Clock::now().time_since_epoch().count();
+  Clock::rep due = next_log_.load(std::memory_order_relaxed);
+  if (now < due) {
+    return;
+  }
+
+  try {
+    std::lock_guard<std::mutex> guard(tracing_mutex_);
+    if (tracing_options_.log_period <= Clock::duration::zero() ||
+        !next_log_.compare_exchange_strong(
+            due, now + tracing_options_.log_period.count())) {
+      return;
+    }
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    for (const auto &trace : GetTraces()) {
+      std::ostringstream line;
+      line << "[" << tracing_options_.name << "] " << trace.name << ": "
+           << trace.count << " calls, mean "
+           << duration_cast<microseconds>(trace.Mean()).count() << " us, p99 "
+           << duration_cast<microseconds>(trace.Percentile(0.99)).count()
+           << " us, max " << duration_cast<microseconds>(trace.max).count()
+           << " us";
+      if (trace.over_budget > 0) {
+        line << ", OVER BUDGET " << trace.over_budget << " times";
+      }
+      tracing_options_.log(line.str());
+    }
+  } catch (...) {
+    // Tracing must not break the notifications.
+  }
 }
 
 }  // namespace sonia_common
@@ -0,0 +1,266 @@
+/**
+ * \file	supervisor.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_SUPERVISOR_H_
+#define SONIA_COMMON_PATTERN_SUPERVISOR_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/runnable.h>
+#include <sonia_common/pattern/subject.h>
+
+namespace sonia_common {
+
+/**
+ * The description of a stalled Runnable, given to the observers of the
+ * Supervisor.
+ */
+struct SupervisorFault {
+  std::string name;
+
+  Runnable *runnable;
+
+  /**
+   * How long the Runnable went without a heartbeat.
+   */
+  std::chrono::steady_clock::duration silence;
+
+  /**
+   * Whether a restart follows. It is attempted after the fault is published,
+   * its outcome is logged and counted in the statistics.
+   */
+  bool restarting;
+};
+
+/**
+ * A watchdog for a set of Runnables.
+ *
+ * The watched Runnables call Heartbeat() in the loop of their Run(), and the
+ * thread of the Supervisor checks at a fixed period that their heartbeat
+ * count moves. When a Runnable goes without a heartbeat for longer than its
+ * timeout, the Action of the Runnable is taken once, until its heartbeats
+ * resume:
+ *
+ * - kLog writes a line with the log function.
+ * - kFault also notifies the observers with a SupervisorFault.
+ * - kRestart also stops and starts the Runnable again, once the fault is
+ *   logged and published.
+ *
+ * The restarts are done one at a time by a restarter thread, so the checks
+ * of the other Runnables go on while a restart waits for a thread to stop.
+ * The Supervisor cannot kill a thread: a restart needs the Runnable to stop
+ * cooperatively, by checking MustStop(), sleeping with WaitFor() or blocking
+ * on its stop event, e.g. with Serial::WaitReadable(GetStopEvent()). A
+ * Runnable blocked for good in a call never completes its restart, and holds
+ * up the restarts after it.
+ *
+ * The Runnables that are not running are not checked, so they can be stopped
+ * without being reported. Unwatch a Runnable before it is destroyed:
+ * Unwatch() and Stop() wait for a restart in progress.
+ */
+class Supervisor : public Runnable, public Subject<const SupervisorFault &> {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<Supervisor>;
+
+  using Clock = std::chrono::steady_clock;
+
+  enum class Action { kLog, kFault, kRestart };
+
+  struct WatchOptions {
+    WatchOptions();
+
+    /**
+     * The name of the Runnable in the log lines and the faults.
+     */
+    std::string name;
+
+    /**
+     * The longest time without a heartbeat before the Action is taken.
+     */
+    Clock::duration timeout;
+
+    Action action;
+  };
+
+  struct LoopStatistics {
+    std::string name;
+
+    uint64_t heartbeats;
+
+    /**
+     * The heartbeat rate in Hz, smoothed over the last checks.
+     */
+    double rate;
+
+    /**
+     * The time since the last heartbeat, with the precision of the check
+     * period.
+     */
+    Clock::duration silence;
+
+    Clock::duration max_silence;
+
+    uint64_t stalls;
+
+    uint64_t restarts;
+
+    bool stalled;
+  };
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param check_period The period at which the heartbeats are checked, the
+   *        precision of the stall detection.
+   * \param log Where the log lines are written, std::clog by default.
+   */
+  explicit Supervisor(
+      Clock::duration check_period = std::chrono::milliseconds(5),
+      std::function<void(const std::string &)> log = nullptr);
+
+  ~Supervisor() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * \throw std::invalid_argument if the Runnable is already watched or the
+   *        timeout is not positive.
+   */
+  void Watch(Runnable &runnable, const WatchOptions &options = WatchOptions());
+
+  /**
+   * \throw std::out_of_range if the Runnable is not watched.
+   */
+  void Unwatch(Runnable &runnable);
+
+  bool IsWatching(const Runnable &runnable) const;
+
+  Clock::duration GetCheckPeriod() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The statistics of the watched Runnables, in the order they were
+   *         watched.
+   */
+  std::vector<LoopStatistics> GetStatistics() const;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void Run() override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Watched {
+    Runnable *runnable;
+
+    WatchOptions options;
+
+    uint64_t last_count;
+
+    Clock::time_point last_progress;
+
+    Clock::time_point last_check;
+
+    LoopStatistics statistics;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Check the heartbeats of the watched Runnables and take the actions.
+   */
+  void Check();
+
+  /**
+   * The loop of the restarter thread: stop and start the Runnables of the
+   * restart queue again, without holding the lock meanwhile.
+   */
+  void RunRestarts();
+
+  /**
+   * \return The entry of the Runnable, or the end of watched_. Called with
+   *         the lock held.
+   */
+  std::vector<Watched>::iterator FindWatched(const Runnable *runnable)
+      ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  const Clock::duration check_period_;
+
+  std::function<void(const std::string &)> log_;
+
+  mutable std::mutex watched_mutex_;
+
+  std::condition_variable restart_wanted_;
+
+  std::condition_variable restart_done_;
+
+  /**
+   * The stalled Runnables waiting for the restarter thread.
+   */
+  std::deque<Runnable *> restart_queue_;
+
+  /**
+   * The Runnable being restarted. It is not checked meanwhile, and
+   * Unwatch() waits for it.
+   */
+  Runnable *restarting_;
+
+  bool restarter_stopping_;
+
+  /**
+   * The outcomes of the restarts, logged by the next Check().
+   */
+  std::vector<std::string> restart_lines_;
+
+  std::vector<Watched> watched_;
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/supervisor_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_SUPERVISOR_H_
@@ -0,0 +1,350 @@
+/**
+ * \file	supervisor_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_SUPERVISOR_H_
+#error This file may only be included from supervisor.h
+#endif
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace sonia_common {
+
+//==============================================================================
+// C / D T O R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Supervisor::WatchOptions::WatchOptions()
+    : name("runnable"),
+      timeout(std::chrono::milliseconds(100)),
+      action(Action::kLog) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Supervisor::Supervisor(
+    Clock::duration check_period, std::function<void(const std::string &)> log)
+    : Runnable(),
+      Subject<const SupervisorFault &>(),
+      check_period_(check_period),
+      log_(std::move(log)),
+      watched_mutex_(),
+      restart_wanted_(),
+      restart_done_(),
+      restart_queue_(),
+      restarting_(nullptr),
+      restarter_stopping_(false),
+      restart_lines_(),
+      watched_() {
+  if (check_period_ <= Clock::duration::zero()) {
+    throw std::invalid_argument("The check period must be positive.");
+  }
+  if (!log_) {
+    log_ = [](const std::string &line) { std::clog << line << std::endl; };
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Supervisor::~Supervisor() ATLAS_NOEXCEPT {
+  // Run() uses the members of this class: stop before they are destroyed.
+  if (IsRunning()) {
+    Stop();
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Supervisor::Watch(Runnable &runnable,
+                                    const WatchOptions &options) {
+  if (options.timeout <= Clock::duration::zero()) {
+    throw std::invalid_argument("The timeout must be positive.");
+  }
+
+  std::lock_guard<std::mutex> lock(watched_mutex_);
+  for (const auto &watched : watched_) {
+    if (watched.runnable == &runnable) {
+      throw std::invalid_argument("The Runnable is already watched.");
+    }
+  }
+
+  const auto now = Clock::now();
+  Watched watched;
+  watched.runnable = &runnable;
+  watched.options = options;
+  watched.last_count = runnable.GetHeartbeatCount();
+  watched.last_progress = now;
+  watched.last_check = now;
+  watched.statistics = LoopStatistics();
+  watched.statistics.name = options.name;
+  watched_.push_back(std::move(watched));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Supervisor::Unwatch(Runnable &runnable) {
+  std::unique_lock<std::mutex> lock(watched_mutex_);
+  // The caller may destroy the Runnable once it is unwatched.
+  restart_done_.wait(lock, [&] { return restarting_ != &runnable; });
+  restart_queue_.erase(
+      std::remove(restart_queue_.begin(), restart_queue_.end(), &runnable),
+      restart_queue_.end());
+  for (auto it = watched_.begin(); it != watched_.end(); ++it) {
+    if (it->runnable == &runnable) {
+      watched_.erase(it);
+      return;
+    }
+  }
+  throw std::out_of_range("The Runnable is not watched.");
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Supervisor::IsWatching(const Runnable &runnable) const {
+  std::lock_guard<std::mutex> lock(watched_mutex_);
+  for (const auto &watched : watched_) {
+    if (watched.runnable == &runnable) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Supervisor::Clock::duration Supervisor::GetCheckPeriod() const
+    ATLAS_NOEXCEPT {
+  return check_period_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::vector<Supervisor::LoopStatistics>
+Supervisor::GetStatistics() const {
+  std::lock_guard<std::mutex> lock(watched_mutex_);
+  std::vector<LoopStatistics> statistics;
+  statistics.reserve(watched_.size());
+  for (const auto &watched : watched_) {
+    statistics.push_back(watched.statistics);
+  }
+  return statistics;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Supervisor::Run() {
+  {
+    std::lock_guard<std::mutex> lock(watched_mutex_);
+    restarter_stopping_ = false;
+  }
+  std::thread restarter(&Supervisor::RunRestarts, this);
+
+  while (WaitFor(check_period_)) {
+    Check();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(watched_mutex_);
+    restarter_stopping_ = true;
+    restart_queue_.clear();
+  }
+  restart_wanted_.notify_all();
+  restarter.join();
+
+  std::vector<std::string> lines;
+  {
+    std::lock_guard<std::mutex> lock(watched_mutex_);
+    lines.swap(restart_lines_);
+  }
+  for (const auto &line : lines) {
+    log_(line);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Supervisor::Check() {
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+
+  // The log lines and the notifications are done without the lock, so the
+  // observers may call the methods of the Supervisor.
+  std::vector<std::string> lines;
+  std::vector<SupervisorFault> faults;
+  std::vector<Action> actions;
+  {
+    std::lock_guard<std::mutex> lock(watched_mutex_);
+    lines.swap(restart_lines_);
+    const auto now = Clock::now();
+    for (auto &watched : watched_) {
+      if (watched.runnable == restarting_) {
+        // The restarter thread is stopping and starting it.
+        continue;
+      }
+
+      auto &statistics = watched.statistics;
+      const uint64_t count = watched.runnable->GetHeartbeatCount();
+      const uint64_t beats = count - watched.last_count;
+      const double elapsed =
+          std::chrono::duration<double>(now - watched.last_check).count();
+      watched.last_check = now;
+      if (elapsed > 0.0) {
+        statistics.rate = 0.8 * statistics.rate + 0.2 * (beats / elapsed);
+      }
+      if (beats != 0) {
+        statistics.heartbeats += beats;
+        statistics.stalled = false;
+        watched.last_count = count;
+        watched.last_progress = now;
+      }
+
+      if (!watched.runnable->IsRunning()) {
+        watched.last_progress = now;
+        statistics.silence = Clock::duration::zero();
+        continue;
+      }
+
+      statistics.silence = now - watched.last_progress;
+      statistics.max_silence =
+          std::max(statistics.max_silence, statistics.silence);
+      if (statistics.stalled || statistics.silence <= watched.options.timeout) {
+        continue;
+      }
+
+      statistics.stalled = true;
+      ++statistics.stalls;
+      SupervisorFault fault;
+      fault.name = watched.options.name;
+      fault.runnable = watched.runnable;
+      fault.silence = statistics.silence;
+      fault.restarting = watched.options.action == Action::kRestart;
+      faults.push_back(fault);
+      actions.push_back(watched.options.action);
+    }
+  }
+
+  for (const auto &fault : faults) {
+    std::ostringstream line;
+    line << "[supervisor] " << fault.name << ": no heartbeat for "
+         << duration_cast<milliseconds>(fault.silence).count() << " ms";
+    if (fault.restarting) {
+      line << ", restarting";
+    }
+    lines.push_back(line.str());
+  }
+  for (const auto &line : lines) {
+    log_(line);
+  }
+  for (size_t i = 0; i < faults.size(); ++i) {
+    if (actions[i] != Action::kLog) {
+      Notify(faults[i]);
+    }
+  }
+
+  // Only now the fault is known: a restart may wait for good on a thread
+  // that does not stop.
+  bool restart = false;
+  {
+    std::lock_guard<std::mutex> lock(watched_mutex_);
+    for (const auto &fault : faults) {
+      if (fault.restarting) {
+        restart_queue_.push_back(fault.runnable);
+        restart = true;
+      }
+    }
+  }
+  if (restart) {
+    restart_wanted_.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Supervisor::RunRestarts() {
+  std::unique_lock<std::mutex> lock(watched_mutex_);
+  for (;;) {
+    restart_wanted_.wait(lock, [this] {
+      return restarter_stopping_ || !restart_queue_.empty();
+    });
+    if (restarter_stopping_) {
+      return;
+    }
+
+    Runnable *runnable = restart_queue_.front();
+    restart_queue_.pop_front();
+    auto watched = FindWatched(runnable);
+    if (watched == watched_.end()) {
+      // Unwatched since the check, it may be destroyed already.
+      continue;
+    }
+    const std::string name = watched->options.name;
+    restarting_ = runnable;
+    lock.unlock();
+
+    bool restarted = true;
+    try {
+      if (runnable->IsRunning()) {
+        runnable->Stop();
+      }
+      runnable->Start();
+    } catch (const std::exception &) {
+      restarted = false;
+    }
+
+    lock.lock();
+    restarting_ = nullptr;
+    restart_done_.notify_all();
+    // Unwatch() waited for the restart, but the entries may have moved.
+    watched = FindWatched(runnable);
+    if (restarted && watched != watched_.end()) {
+      ++watched->statistics.restarts;
+      // Give the new thread a full timeout before its first heartbeat.
+      watched->statistics.stalled = false;
+      watched->last_count = runnable->GetHeartbeatCount();
+      watched->last_progress = Clock::now();
+    }
+    // Written by the thread of the Supervisor, the only one calling log_.
+    restart_lines_.push_back("[supervisor] " + name +
+                             (restarted ? ": restarted" : ": restart failed"));
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::vector<Supervisor::Watched>::iterator
+Supervisor::FindWatched(const Runnable *runnable) ATLAS_NOEXCEPT {
+  return std::find_if(watched_.begin(), watched_.end(),
+                      [runnable](const Watched &watched) {
+                        return watched.runnable == runnable;
+                      });
+}
+
+}  // namespace sonia_common
@@ -0,0 +1,173 @@
+/**
+ * \file	task.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_TASK_H_
+#define SONIA_COMMON_PATTERN_TASK_H_
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <sonia_common/macros.h>
+
+namespace sonia_common {
+
+//==============================================================================
+// C L A S S E S
+
+/**
+ * A move-only callable taking no argument and returning nothing.
+ *
+ * This is what the ThreadPool stores in its queues. Unlike std::function,
+ * a Task can hold move-only callables (e.g. a std::packaged_task) and keeps
+ * any callable that fits in kInlineSize bytes in an inline buffer, so
+ * building, moving and running a small task never touches the allocator.
+ * Bigger callables are moved to the heap.
+ *
+ * When the ThreadPool metrics are compiled in (SONIA_THREAD_POOL_METRICS),
+ * a Task also carries the time it has been enqueued at. It then fills the
+ * rest of its cache line.
+ */
+class Task {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  /**
+   * The size of the inline buffer. A lambda capturing up to six pointers
+   * fits in it, which keeps a Task in a single cache line.
+   */
+  enum : size_t { kInlineSize = 48 };
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  Task() ATLAS_NOEXCEPT;
+
+  template <class Fp_,
+            class = typename std::enable_if<!std::is_same<
+                typename std::decay<Fp_>::type, Task>::value>::type>
+  Task(Fp_ &&f);
+
+  Task(Task &&rhs) ATLAS_NOEXCEPT;
+
+  Task(const Task &) = delete;
+
+  ~Task() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  Task &operator=(Task &&rhs) ATLAS_NOEXCEPT;
+
+  Task &operator=(const Task &) = delete;
+
+  /**
+   * Run the stored callable. The task must not be empty.
+   */
+  void operator()();
+
+  /**
+   * \return Either if a callable is stored in this task.
+   */
+  explicit operator bool() const ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * \return Either if the callable is stored in the inline buffer.
+   */
+  bool IsInline() const ATLAS_NOEXCEPT;
+
+  /**
+   * Destroy the stored callable, if any.
+   */
+  void Reset() ATLAS_NOEXCEPT;
+
+  /**
+   * \return Either if a callable of type Fp_ is stored without allocating.
+   */
+  template <class Fp_>
+  static constexpr bool FitsInline() ATLAS_NOEXCEPT;
+
+#if defined(SONIA_THREAD_POOL_METRICS)
+  void SetEnqueueTime(std::chrono::steady_clock::time_point time)
+      ATLAS_NOEXCEPT;
+
+  std::chrono::steady_clock::time_point GetEnqueueTime() const ATLAS_NOEXCEPT;
+#endif
+
+ private:
+  //==========================================================================
+  // P R I V A T E   T Y P E S
+
+  using Storage = typename std::aligned_storage<kInlineSize,
+                                                alignof(std::max_align_t)>::type;
+
+  /**
+   * The type erased operations of the stored callable.
+   */
+  struct Operations {
+    void (*invoke)(Storage &);
+    void (*move)(Storage &dst, Storage &src);
+    void (*destroy)(Storage &);
+    bool is_inline;
+  };
+
+  template <class Fp_>
+  struct InlineOperations;
+
+  template <class Fp_>
+  struct HeapOperations;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  template <class Fp_>
+  void Construct(Fp_ &&f, std::true_type is_inline);
+
+  template <class Fp_>
+  void Construct(Fp_ &&f, std::false_type is_inline);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  Storage storage_;
+
+  const Operations *operations_;
+
+#if defined(SONIA_THREAD_POOL_METRICS)
+  std::chrono::steady_clock::time_point enqueue_time_;
+#endif
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/task_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_TASK_H_
@@ -0,0 +1,148 @@
+/**
+ * \file	task_graph.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_TASK_GRAPH_H_
+#define SONIA_COMMON_PATTERN_TASK_GRAPH_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/future.h>
+#include <sonia_common/pattern/thread_pool.h>
+
+namespace sonia_common {
+
+/**
+ * A set of tasks with dependencies between them, run on a ThreadPool.
+ *
+ * The graph is built once, then every call to Run() executes all of its
+ * tasks: a task is enqueued as soon as the last of its dependencies is done,
+ * so independent branches run in parallel and no worker waits on another
+ * one. A worker that completes a task runs one of the tasks it unblocks
+ * itself and enqueues the other ones.
+ *
+ * The graph is always acyclic, adding a dependency that would create a cycle
+ * throws. Several runs of the same graph can be in progress at once, e.g.
+ * to overlap the processing of consecutive frames, and modifying the graph
+ * does not affect the runs already started.
+ */
+class TaskGraph {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<TaskGraph>;
+
+  using NodeId = size_t;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  TaskGraph();
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * Add a task to the graph.
+   *
+   * \return The identifier of the node, to use in dependencies.
+   */
+  NodeId AddNode(std::function<void()> task);
+
+  /**
+   * Add a task that runs once all the given nodes are done.
+   */
+  NodeId AddNode(std::function<void()> task,
+                 const std::vector<NodeId> &dependencies);
+
+  /**
+   * Make after wait for before to be done.
+   *
+   * Throws a std::out_of_range if one of the nodes does not exist, or a
+   * std::logic_error if after is already a dependency of before.
+   */
+  void AddDependency(NodeId before, NodeId after);
+
+  /**
+   * \return The number of nodes in the graph.
+   */
+  size_t Size() const ATLAS_NOEXCEPT;
+
+  /**
+   * Enqueue the tasks that have no dependency on the pool, the other ones
+   * follow as their dependencies complete.
+   *
+   * If a task throws, the tasks that are not started yet are skipped and the
+   * first exception is set on the returned future.
+   *
+   * \return A future that is ready once all the tasks are done.
+   */
+  Future<void> Run(ThreadPool &pool) const;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Node {
+    std::function<void()> task;
+    std::vector<NodeId> successors;
+    size_t dependencies;
+  };
+
+  using Nodes = std::vector<Node>;
+
+  struct Execution;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * \return The nodes, copied first if a run still uses them.
+   */
+  Nodes &MutableNodes();
+
+  void CheckNode(NodeId node) const;
+
+  bool Reaches(NodeId from, NodeId to) const;
+
+  static void Execute(ThreadPool &pool,
+                      const std::shared_ptr<Execution> &execution,
+                      NodeId node);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::shared_ptr<Nodes> nodes_;
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/pattern/task_graph_inl.h>
+
+#endif  // SONIA_COMMON_PATTERN_TASK_GRAPH_H_
@@ -0,0 +1,218 @@
+/**
+ * \file	task_graph_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_TASK_GRAPH_H_
+#error This file may only be included from task_graph.h
+#endif
+
+#include <exception>
+#include <limits>
+#include <stdexcept>
+
+namespace sonia_common {
+
+//==============================================================================
+// T Y P E S   S E C T I O N
+
+/**
+ * The state of one run of the graph.
+ */
+struct TaskGraph::Execution {
+  explicit Execution(const std::shared_ptr<const Nodes> &graph)
+      : nodes(graph),
+        dependencies(new std::atomic<size_t>[graph->size()]),
+        remaining(graph->size()),
+        failed(false),
+        error(),
+        promise() {
+    for (size_t i = 0; i < nodes->size(); ++i) {
+      dependencies[i] = (*nodes)[i].dependencies;
+    }
+  }
+
+  std::shared_ptr<const Nodes> nodes;
+  std::unique_ptr<std::atomic<size_t>[]> dependencies;
+  std::atomic<size_t> remaining;
+  std::atomic<bool> failed;
+  std::exception_ptr error;
+  Promise<void> promise;
+};
+
+//==============================================================================
+// C / D T O R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TaskGraph::TaskGraph() : nodes_(std::make_shared<Nodes>()) {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TaskGraph::NodeId TaskGraph::AddNode(std::function<void()> task) {
+  return AddNode(std::move(task), std::vector<NodeId>());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TaskGraph::NodeId TaskGraph::AddNode(
+    std::function<void()> task, const std::vector<NodeId> &dependencies) {
+  for (auto dependency : dependencies) {
+    CheckNode(dependency);
+  }
+
+  auto &nodes = MutableNodes();
+  NodeId id = nodes.size();
+  nodes.push_back(Node{std::move(task), std::vector<NodeId>(), 0});
+  for (auto dependency : dependencies) {
+    nodes[dependency].successors.push_back(id);
+    ++nodes[id].dependencies;
+  }
+  return id;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TaskGraph::AddDependency(NodeId before, NodeId after) {
+  CheckNode(before);
+  CheckNode(after);
+  if (before == after || Reaches(after, before)) {
+    throw std::logic_error("the dependency would create a cycle");
+  }
+
+  auto &nodes = MutableNodes();
+  nodes[before].successors.push_back(after);
+  ++nodes[after].dependencies;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t TaskGraph::Size() const ATLAS_NOEXCEPT {
+  return nodes_->size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Future<void> TaskGraph::Run(ThreadPool &pool) const {
+  auto execution = std::make_shared<Execution>(nodes_);
+  Future<void> future = execution->promise.GetFuture();
+  if (nodes_->empty()) {
+    execution->promise.SetValue();
+    return future;
+  }
+
+  for (NodeId i = 0; i < nodes_->size(); ++i) {
+    if ((*nodes_)[i].dependencies == 0) {
+      pool.EnqueueDetached([&pool, execution, i] { Execute(pool, execution, i); });
+    }
+  }
+  return future;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE TaskGraph::Nodes &TaskGraph::MutableNodes() {
+  if (nodes_.use_count() > 1) {
+    nodes_ = std::make_shared<Nodes>(*nodes_);
+  }
+  return *nodes_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TaskGraph::CheckNode(NodeId node) const {
+  if (node >= nodes_->size()) {
+    throw std::out_of_range("no such node in the TaskGraph");
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool TaskGraph::Reaches(NodeId from, NodeId to) const {
+  std::vector<bool> visited(nodes_->size(), false);
+  std::vector<NodeId> stack(1, from);
+  while (!stack.empty()) {
+    NodeId node = stack.back();
+    stack.pop_back();
+    if (node == to) {
+      return true;
+    }
+    if (!visited[node]) {
+      visited[node] = true;
+      for (auto successor : (*nodes_)[node].successors) {
+        stack.push_back(successor);
+      }
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void TaskGraph::Execute(
+    ThreadPool &pool, const std::shared_ptr<Execution> &execution,
+    NodeId node) {
+  const NodeId none = std::numeric_limits<NodeId>::max();
+
+  while (node != none) {
+    const Node &current = (*execution->nodes)[node];
+    if (!execution->failed) {
+      try {
+        current.task();
+      } catch (...) {
+        if (!execution->failed.exchange(true)) {
+          execution->error = std::current_exception();
+        }
+      }
+    }
+
+    // Keep the first task that becomes ready for this thread, it saves a
+    // round trip through the queue of the pool.
+    NodeId next = none;
+    for (auto successor : current.successors) {
+      if (execution->dependencies[successor].fetch_sub(1) == 1) {
+        if (next == none) {
+          next = successor;
+        } else {
+          pool.EnqueueDetached([&pool, execution, successor] {
+            Execute(pool, execution, successor);
+          });
+        }
+      }
+    }
+
+    if (execution->remaining.fetch_sub(1) == 1) {
+      if (execution->failed) {
+        execution->promise.SetException(execution->error);
+      } else {
+        execution->promise.SetValue();
+      }
+    }
+    node = next;
+  }
+}
+
+}  // namespace sonia_common
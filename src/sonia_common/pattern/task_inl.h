@@ -0,0 +1,208 @@
+/**
+ * \file	task_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_TASK_H_
+#error This file may only be included from task.h
+#endif
+
+#include <new>
+
+namespace sonia_common {
+
+//==============================================================================
+// O P E R A T I O N S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_>
+struct Task::InlineOperations {
+  static void Invoke(Storage &storage) {
+    (*reinterpret_cast<Fp_ *>(&storage))();
+  }
+
+  static void Move(Storage &dst, Storage &src) {
+    new (&dst) Fp_(std::move(*reinterpret_cast<Fp_ *>(&src)));
+    reinterpret_cast<Fp_ *>(&src)->~Fp_();
+  }
+
+  static void Destroy(Storage &storage) {
+    reinterpret_cast<Fp_ *>(&storage)->~Fp_();
+  }
+
+  static const Operations *Get() ATLAS_NOEXCEPT {
+    static const Operations operations = {&Invoke, &Move, &Destroy, true};
+    return &operations;
+  }
+};
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_>
+struct Task::HeapOperations {
+  static Fp_ *&Pointer(Storage &storage) {
+    return *reinterpret_cast<Fp_ **>(&storage);
+  }
+
+  static void Invoke(Storage &storage) { (*Pointer(storage))(); }
+
+  static void Move(Storage &dst, Storage &src) {
+    new (&dst) Fp_ *(Pointer(src));
+  }
+
+  static void Destroy(Storage &storage) { delete Pointer(storage); }
+
+  static const Operations *Get() ATLAS_NOEXCEPT {
+    static const Operations operations = {&Invoke, &Move, &Destroy, false};
+    return &operations;
+  }
+};
+
+//==============================================================================
+// C / D T O R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Task::Task() ATLAS_NOEXCEPT : storage_(),
+                                                  operations_(nullptr) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_, class>
+ATLAS_ALWAYS_INLINE Task::Task(Fp_ &&f) : storage_(), operations_(nullptr) {
+  using Callable = typename std::decay<Fp_>::type;
+  Construct(std::forward<Fp_>(f),
+            std::integral_constant<bool, FitsInline<Callable>()>());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Task::Task(Task &&rhs) ATLAS_NOEXCEPT
+    : storage_(),
+      operations_(rhs.operations_) {
+#if defined(SONIA_THREAD_POOL_METRICS)
+  enqueue_time_ = rhs.enqueue_time_;
+#endif
+  if (operations_ != nullptr) {
+    operations_->move(storage_, rhs.storage_);
+    rhs.operations_ = nullptr;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Task::~Task() ATLAS_NOEXCEPT { Reset(); }
+
+//==============================================================================
+// O P E R A T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Task &Task::operator=(Task &&rhs) ATLAS_NOEXCEPT {
+  if (this != &rhs) {
+    Reset();
+#if defined(SONIA_THREAD_POOL_METRICS)
+    enqueue_time_ = rhs.enqueue_time_;
+#endif
+    if (rhs.operations_ != nullptr) {
+      rhs.operations_->move(storage_, rhs.storage_);
+      operations_ = rhs.operations_;
+      rhs.operations_ = nullptr;
+    }
+  }
+  return *this;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void Task::operator()() { operations_->invoke(storage_); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Task::operator bool() const ATLAS_NOEXCEPT {
+  return operations_ != nullptr;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE bool Task::IsInline() const ATLAS_NOEXCEPT {
+  return operations_ != nullptr && operations_->is_inline;
+}
+
+#if defined(SONIA_THREAD_POOL_METRICS)
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void Task::SetEnqueueTime(
+    std::chrono::steady_clock::time_point time) ATLAS_NOEXCEPT {
+  enqueue_time_ = time;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE std::chrono::steady_clock::time_point
+Task::GetEnqueueTime() const ATLAS_NOEXCEPT {
+  return enqueue_time_;
+}
+#endif
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void Task::Reset() ATLAS_NOEXCEPT {
+  if (operations_ != nullptr) {
+    operations_->destroy(storage_);
+    operations_ = nullptr;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_>
+ATLAS_ALWAYS_INLINE void Task::Construct(Fp_ &&f, std::true_type) {
+  using Callable = typename std::decay<Fp_>::type;
+  new (&storage_) Callable(std::forward<Fp_>(f));
+  operations_ = InlineOperations<Callable>::Get();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_>
+ATLAS_ALWAYS_INLINE void Task::Construct(Fp_ &&f, std::false_type) {
+  using Callable = typename std::decay<Fp_>::type;
+  new (&storage_) Callable *(new Callable(std::forward<Fp_>(f)));
+  operations_ = HeapOperations<Callable>::Get();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_>
+ATLAS_ALWAYS_INLINE constexpr bool Task::FitsInline() ATLAS_NOEXCEPT {
+  return sizeof(Fp_) <= kInlineSize &&
+         alignof(std::max_align_t) % alignof(Fp_) == 0 &&
+         std::is_nothrow_move_constructible<Fp_>::value;
+}
+
+}  // namespace sonia_common
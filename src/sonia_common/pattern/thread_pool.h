@@ -26,17 +26,24 @@
 #ifndef SONIA_COMMON_PATTERN_THREAD_POOL_H_
 #define SONIA_COMMON_PATTERN_THREAD_POOL_H_
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <stdexcept>
 #include <thread>
 #include <vector>
 
 #include <sonia_common/macros.h>
+#include <sonia_common/pattern/details/mpmc_queue.h>
+#include <sonia_common/pattern/details/task_queue.h>
+#include <sonia_common/pattern/details/timer_queue.h>
+#include <sonia_common/pattern/task.h>
+#include <sonia_common/sys/latency_histogram.h>
+#include <sonia_common/sys/thread_options.h>
 
 namespace sonia_common {
 
@@ -53,6 +60,23 @@ namespace sonia_common {
  * an instance of a task in, for exemple, a loop. You could use a thread pool
  * for your application and simply add a thread in this pool fo your need.
  *
+ * The pool can run on three backends, see ThreadPool::Backend. The default
+ * one is the original single shared queue. The work stealing backend gives
+ * each worker its own deque so producers and workers stop contending on a
+ * single lock, and the lock-free ring backend replaces the queue and its
+ * mutex by a bounded lock-free ring buffer.
+ *
+ * On top of the backend, a task can be given a priority or a deadline, see
+ * EnqueueWithPriority() and EnqueueWithDeadline(). The tasks are dispatched
+ * in this order: the tasks with a deadline, earliest deadline first, then the
+ * high, normal and low priority lanes.
+ *
+ * With Options::max_threads, the pool is elastic: it adds workers when the
+ * queued tasks pile up and retires the ones that stay idle.
+ *
+ * Define SONIA_THREAD_POOL_METRICS to compile in the metrics of the pool,
+ * see GetMetrics(). Without it, they cost nothing.
+ *
  * This thread pool is based on this open implementation from:
  * https://github.com/progschj/ThreadPool
  */
@@ -63,11 +87,216 @@ class ThreadPool {
 
   using Ptr = std::shared_ptr<ThreadPool>;
 
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * The lane a task is queued in. The normal lane is the one of Enqueue()
+   * and is the only one going through the backend, the high and low lanes
+   * are shared by all the workers.
+   */
+  enum class Priority { kHigh, kNormal, kLow };
+
+  /**
+   * The counters of the tasks enqueued with a deadline.
+   */
+  struct DeadlineStatistics {
+    /**
+     * The number of tasks with a deadline that have been run.
+     */
+    uint64_t tasks;
+
+    /**
+     * The number of those tasks that were started after their deadline.
+     */
+    uint64_t late_starts;
+
+    /**
+     * The number of those tasks that finished after their deadline. This
+     * includes the late starts.
+     */
+    uint64_t misses;
+  };
+
+  /**
+   * The counters of a task scheduled with ScheduleAt(), ScheduleAfter() or
+   * ScheduleEvery(). The lateness is the time between the deadline of a
+   * firing and the moment a worker starts it.
+   */
+  struct TimerStatistics {
+    uint64_t firings;
+
+    /**
+     * The number of firings of a periodic task that have been dropped
+     * because the previous one was still running, or because the timer
+     * thread was too late to honor them.
+     */
+    uint64_t skipped;
+
+    Clock::duration last_lateness;
+
+    Clock::duration max_lateness;
+
+    Clock::duration total_lateness;
+  };
+
+  /**
+   * A copy of a histogram of durations, see LatencyHistogram.
+   */
+  using HistogramSnapshot = LatencyHistogram::Snapshot;
+
+  /**
+   * What the pool has been doing since its creation or the last call to
+   * ResetMetrics().
+   */
+  struct Metrics {
+    Clock::duration elapsed;
+
+    /**
+     * The time between the moment a task is enqueued and the moment it
+     * starts.
+     */
+    HistogramSnapshot wait_time;
+
+    HistogramSnapshot run_time;
+
+    /**
+     * The highest number of tasks waiting in the pool.
+     */
+    size_t queue_high_water_mark;
+
+    /**
+     * The fraction of the elapsed time each worker spent running tasks.
+     */
+    std::vector<double> worker_busy_ratio;
+  };
+
+  /**
+   * The handle of a scheduled task, used to cancel it.
+   *
+   * Dropping the handle does not cancel the task.
+   */
+  class TimerHandle {
+   public:
+    TimerHandle() ATLAS_NOEXCEPT;
+
+    /**
+     * Prevent any further firing of the task. A firing that already started
+     * is not interrupted.
+     */
+    void Cancel() ATLAS_NOEXCEPT;
+
+    /**
+     * \return Either if the task has been cancelled.
+     */
+    bool IsCancelled() const ATLAS_NOEXCEPT;
+
+    TimerStatistics GetStatistics() const ATLAS_NOEXCEPT;
+
+   private:
+    friend class ThreadPool;
+
+    explicit TimerHandle(const std::shared_ptr<details::TimerEntry> &entry)
+        ATLAS_NOEXCEPT;
+
+    std::shared_ptr<details::TimerEntry> entry_;
+  };
+
+  /**
+   * The way the tasks are handed from the producers to the workers.
+   */
+  enum class Backend {
+    /**
+     * All the tasks go through a single FIFO queue guarded by one mutex.
+     */
+    kSharedQueue,
+
+    /**
+     * Each worker owns a deque. A worker pops its own tasks LIFO and, when
+     * it runs out of work, steals FIFO from the other workers.
+     * A task enqueued from inside a worker goes to that worker's deque, the
+     * other ones are distributed round robin.
+     */
+    kWorkStealing,
+
+    /**
+     * All the tasks go through a bounded lock-free ring buffer. The idle
+     * workers poll the ring for a while before parking, so a task enqueued
+     * on a busy pool is handed over without any mutex or condition variable.
+     * A producer finding the ring full waits for a free cell, or runs pending
+     * tasks itself if it is a worker of the pool.
+     */
+    kLockFreeRing
+  };
+
+  /**
+   * The construction options of a ThreadPool.
+   */
+  struct Options {
+    Options() ATLAS_NOEXCEPT;
+
+    Backend backend;
+
+    /**
+     * The number of tasks the ring of the lock-free backend can hold. It is
+     * rounded up to a power of two.
+     */
+    size_t ring_capacity;
+
+    /**
+     * The number of times an idle worker of the work stealing and lock-free
+     * backends polls for a task before it parks on the condition variable.
+     * Spinning saves the wake-up latency at the cost of CPU time.
+     */
+    size_t spin_count;
+
+    /**
+     * The options applied by every worker before it takes its first task.
+     * If a name is given, the index of the worker is appended to it.
+     */
+    ThreadOptions thread_options;
+
+    /**
+     * The maximum number of workers of an elastic pool. The number given to
+     * the constructor is then the minimum one. Leave it to 0, or to the
+     * minimum, for a pool of a fixed size.
+     * Elastic pools run on the shared queue and lock-free ring backends only.
+     */
+    size_t max_threads;
+
+    /**
+     * An elastic pool adds a worker when a task is enqueued and more than
+     * grow_queue_depth tasks per worker are queued, not counting the ones
+     * the idle workers are about to take...
+     */
+    size_t grow_queue_depth;
+
+    /**
+     * ...or when no worker has started a task for grow_wait_time.
+     */
+    Clock::duration grow_wait_time;
+
+    /**
+     * The time after which an idle worker of an elastic pool is retired,
+     * down to the minimum number of workers.
+     */
+    Clock::duration idle_timeout;
+  };
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
   explicit ThreadPool(size_t) ATLAS_NOEXCEPT;
 
+  /**
+   * Create the pool with the given options.
+   *
+   * Throws a std::system_error if the thread options cannot be applied on
+   * the workers, after the workers have been stopped, or a
+   * std::invalid_argument if an elastic pool is asked on the work stealing
+   * backend, whose deques are created with the pool.
+   */
+  ThreadPool(size_t, const Options &);
+
   ~ThreadPool() ATLAS_NOEXCEPT;
 
   //============================================================================
@@ -77,95 +306,409 @@ class ThreadPool {
   std::future<typename std::result_of<Tp_(Args_...)>::type> Enqueue(
       Tp_ &&f, Args_ &&... args);
 
+  /**
+   * Enqueue a task in the lane of the given priority. A worker always takes
+   * the tasks of the high lane before the normal and low ones.
+   */
+  template <class Tp_, class... Args_>
+  std::future<typename std::result_of<Tp_(Args_...)>::type> EnqueueWithPriority(
+      Priority priority, Tp_ &&f, Args_ &&... args);
+
+  /**
+   * Enqueue a task that should be done before the given deadline.
+   *
+   * The tasks with a deadline are taken before any other one, earliest
+   * deadline first. The tasks started or finished past their deadline are
+   * counted, see GetDeadlineStatistics().
+   */
+  template <class Tp_, class... Args_>
+  std::future<typename std::result_of<Tp_(Args_...)>::type> EnqueueWithDeadline(
+      Clock::time_point deadline, Tp_ &&f, Args_ &&... args);
+
+  /**
+   * Enqueue a fire-and-forget task.
+   *
+   * No future is created, so unlike Enqueue(), a callable small enough to fit
+   * in the inline buffer of a Task is queued and run without any allocation.
+   * Any exception thrown by the task is swallowed: report errors through the
+   * captured state instead.
+   */
+  template <class Tp_>
+  void EnqueueDetached(Tp_ &&f);
+
+  template <class Tp_, class Arg_, class... Args_>
+  void EnqueueDetached(Tp_ &&f, Arg_ &&arg, Args_ &&... args);
+
+  /**
+   * Enqueue f on the pool at the given point of time.
+   *
+   * The pool waits for the deadlines of all its scheduled tasks on a single
+   * timer thread, started by the first call. Like for EnqueueDetached(),
+   * exceptions thrown by f are swallowed.
+   */
+  template <class Fp_>
+  TimerHandle ScheduleAt(Clock::time_point deadline, Fp_ &&f);
+
+  template <class Fp_>
+  TimerHandle ScheduleAfter(Clock::duration delay, Fp_ &&f);
+
+  /**
+   * Enqueue f on the pool every period, the first time one period from now.
+   *
+   * The deadlines are absolute, so the period does not drift with the time
+   * it takes to dispatch the task. A firing is skipped if the previous one
+   * is still queued or running. Throws a std::invalid_argument if the period
+   * is not positive.
+   */
+  template <class Fp_>
+  TimerHandle ScheduleEvery(Clock::duration period, Fp_ &&f);
+
+  /**
+   * Call f(i) for every i in [begin, end) using the workers of the pool.
+   *
+   * The range is split in halves until the chunks are smaller than grain.
+   * One half is enqueued and the other one is processed right away, so the
+   * idle workers steal the biggest chunks first and the load balances itself.
+   * A grain of 0 picks one that gives a few chunks per thread.
+   *
+   * The calling thread processes chunks too and runs the pending tasks of
+   * the pool while it waits for the other ones, so it is safe to call this
+   * from inside a task. The first exception thrown by f is rethrown here once
+   * all the chunks are done.
+   */
+  template <class Index_, class Fp_>
+  void ParallelFor(Index_ begin, Index_ end, Index_ grain, Fp_ &&f);
+
+  /**
+   * Reduce the values of map(i) for every i in [begin, end) with reduce.
+   *
+   * The range is split like in ParallelFor(). Each chunk is reduced locally
+   * starting from identity, then the partial results are combined, in no
+   * particular order, so reduce must be associative and commutative.
+   *
+   * \return The reduction of all the values, identity if the range is empty.
+   */
+  template <class Index_, class Tp_, class Mp_, class Rp_>
+  Tp_ ParallelReduce(Index_ begin, Index_ end, Index_ grain, Tp_ identity,
+                     Mp_ &&map, Rp_ &&reduce);
+
+  /**
+   * Run one of the tasks waiting in the pool on the calling thread.
+   *
+   * This is what lets a thread make itself useful while it waits for the
+   * result of other tasks instead of blocking a worker.
+   *
+   * \return Either if a task has been run.
+   */
+  bool RunPendingTask();
+
+  /**
+   * \return The counters of the tasks enqueued with a deadline.
+   */
+  DeadlineStatistics GetDeadlineStatistics() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of worker threads of this pool, which changes over
+   *         time for an elastic pool.
+   */
+  size_t Size() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The fraction of the workers that are running a task right now.
+   */
+  double GetUtilization() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return Either if the metrics are compiled in.
+   */
+  static constexpr bool HasMetrics() ATLAS_NOEXCEPT;
+
+  /**
+   * \return A snapshot of the metrics of the pool. Every value is null if
+   *         they are not compiled in.
+   */
+  Metrics GetMetrics() const;
+
+  void ResetMetrics() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The backend the pool has been created with.
+   */
+  Backend GetBackend() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return Either if the calling thread is one of the workers of this pool.
+   */
+  bool IsWorkerThread() const ATLAS_NOEXCEPT;
+
  private:
+  //==========================================================================
+  // P R I V A T E   T Y P E S
+
+  /**
+   * The deque owned by a worker when running on the work stealing backend.
+   * The owner works on the back, thieves take from the front.
+   */
+  struct WorkerQueue {
+    std::mutex mutex;
+    details::TaskQueue tasks;
+  };
+
+  /**
+   * Identifies the pool and the worker the calling thread belongs to, if any.
+   */
+  struct WorkerContext {
+    const ThreadPool *pool;
+    size_t index;
+  };
+
+  /**
+   * A task of the deadline queue. The sequence keeps the tasks with the same
+   * deadline in FIFO order.
+   */
+  struct DeadlineTask {
+    Clock::time_point deadline;
+    uint64_t sequence;
+    Task task;
+  };
+
+  struct LaterDeadline {
+    bool operator()(const DeadlineTask &lhs, const DeadlineTask &rhs) const;
+  };
+
+#if defined(SONIA_THREAD_POOL_METRICS)
+  /**
+   * The counters behind GetMetrics(). The busy time of the workers is indexed
+   * like the workers, up to the maximum size of the pool.
+   */
+  struct MetricsState {
+    explicit MetricsState(size_t workers);
+
+    std::atomic<Clock::rep> start;
+    LatencyHistogram wait_time;
+    LatencyHistogram run_time;
+    std::atomic<size_t> queue_high_water_mark;
+    std::vector<std::atomic<uint64_t>> worker_busy_time;
+  };
+#endif
+
+  /**
+   * The state shared by all the chunks of a ParallelFor() call. It lives on
+   * the stack of the caller, which waits for all the chunks to be done.
+   */
+  template <class Index_, class Body_>
+  struct ParallelState {
+    ParallelState(Index_ grain, Body_ &body);
+
+    Index_ grain;
+    Body_ &body;
+    std::atomic<size_t> pending;
+    std::atomic<bool> failed;
+    std::exception_ptr error;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  static WorkerContext &CurrentWorker() ATLAS_NOEXCEPT;
+
+  template <class Tp_, class... Args_>
+  static std::packaged_task<typename std::result_of<Tp_(Args_...)>::type()>
+  Package(Tp_ &&f, Args_ &&... args);
+
+  void Push(Task &&task);
+
+  void PushShared(Task &&task);
+
+  void PushWorkStealing(Task &&task);
+
+  void PushLockFree(Task &&task);
+
+  void PushToLane(Priority priority, Task &&task);
+
+  void PushWithDeadline(Clock::time_point deadline, Task &&task);
+
+  /**
+   * Record the time the task is enqueued at, for the metrics.
+   */
+  void StampEnqueue(Task &task) const ATLAS_NOEXCEPT;
+
+  /**
+   * Record the number of queued tasks after an enqueue, for the metrics.
+   */
+  void RecordQueueDepth() ATLAS_NOEXCEPT;
+
+  TimerHandle Schedule(Clock::time_point deadline, Clock::duration period,
+                       std::function<void()> task);
+
+  /**
+   * Apply the thread options on the calling worker and report the result in
+   * the promise.
+   *
+   * \return Either if the worker could be configured.
+   */
+  bool ConfigureWorker(size_t index, std::promise<void> &configured);
+
+  /**
+   * The body of a worker, once configured.
+   */
+  void Work(size_t index);
+
+  void SharedQueueLoop(size_t index);
+
+  /**
+   * The loop of the workers of the work stealing and lock-free backends.
+   */
+  void WorkerLoop(size_t index);
+
+  /**
+   * Wake up one parked worker, if any, after a task has been queued.
+   */
+  void NotifyIdleWorker();
+
+  /**
+   * Park the calling worker until there is a task to run.
+   * The queue_mutex_ must be held.
+   *
+   * \return false if the worker must exit, because the pool is stopped or
+   *         because it has been retired.
+   */
+  bool WaitForTask(std::unique_lock<std::mutex> &lock, size_t index);
+
+  /**
+   * Add a worker to an elastic pool if the queued tasks are waiting for one.
+   */
+  void GrowIfNeeded();
+
+  void AddWorker();
+
+  /**
+   * Take the next task to run, in the dispatch order of the pool.
+   *
+   * \param index The index of the calling worker, or the number of worker
+   *        queues if the caller is not a worker.
+   * \param deadline Set to the deadline of the task, Clock::time_point::max()
+   *        if it has none.
+   */
+  bool PopTask(size_t index, Task &task, Clock::time_point &deadline);
+
+  /**
+   * Take a task from the lanes and from the shared queue.
+   * The queue_mutex_ must be held.
+   */
+  bool PopSharedTask(Task &task, Clock::time_point &deadline);
+
+  /**
+   * Take a task from the deadline queue or from the high priority lane.
+   * The queue_mutex_ must be held.
+   */
+  bool PopUrgentTask(Task &task, Clock::time_point &deadline);
+
+  bool PopLocalTask(size_t index, Task &task);
+
+  bool StealTask(size_t index, Task &task);
+
+  void Run(Task &task, Clock::time_point deadline) ATLAS_NOEXCEPT;
+
+  /**
+   * Run the task on the given worker, accounting for its busy time.
+   */
+  void RunOnWorker(size_t index, Task &task,
+                   Clock::time_point deadline) ATLAS_NOEXCEPT;
+
+  template <class Index_, class Body_>
+  void RunParallel(Index_ begin, Index_ end, Index_ grain, Body_ &body);
+
+  template <class Index_, class Body_>
+  void RunChunk(ParallelState<Index_, Body_> *state, Index_ begin, Index_ end);
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
+  Options options_;
+
+  /**
+   * The threads of the workers, indexed by worker. The slot of a retired
+   * worker is reused by the next one added.
+   */
   std::vector<std::thread> workers_;
 
-  std::queue<std::function<void()>> tasks_;
+  std::vector<size_t> retired_workers_;
 
-  mutable std::mutex queue_mutex_;
+  const size_t min_workers_;
 
-  std::condition_variable condition_;
+  std::atomic<size_t> active_workers_;
 
-  bool is_stoped_;
-};
+  std::atomic<size_t> busy_workers_;
 
-//==============================================================================
-// C / D T O R   S E C T I O N
-
-//------------------------------------------------------------------------------
-//
-ThreadPool::ThreadPool(size_t threads) ATLAS_NOEXCEPT : workers_(),
-                                                        tasks_(),
-                                                        queue_mutex_(),
-                                                        condition_(),
-                                                        is_stoped_(false) {
-  for (size_t i = 0; i < threads; ++i) {
-    workers_.emplace_back([this] {
-      for (;;) {
-        std::function<void()> task;
-
-        {
-          auto lock = std::unique_lock<std::mutex>{queue_mutex_};
-          condition_.wait(lock,
-                          [this] { return is_stoped_ || !tasks_.empty(); });
-          if (is_stoped_ && tasks_.empty()) {
-            return;
-          }
-          task = std::move(tasks_.front());
-          tasks_.pop();
-        }
-
-        task();
-      }
-    });
-  }
-}
-
-//------------------------------------------------------------------------------
-//
-ThreadPool::~ThreadPool() ATLAS_NOEXCEPT {
-  {
-    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
-    is_stoped_ = true;
-  }
-  condition_.notify_all();
-  for (std::thread &worker : workers_) {
-    worker.join();
-  }
-}
+  /**
+   * When a worker last started a task, in ticks of the Clock. Only kept up
+   * to date for an elastic pool.
+   */
+  std::atomic<Clock::rep> last_start_;
 
-//==============================================================================
-// M E T H O D S   S E C T I O N
+#if defined(SONIA_THREAD_POOL_METRICS)
+  std::unique_ptr<MetricsState> metrics_;
+#endif
+
+  details::TaskQueue tasks_;
+
+  details::TaskQueue high_tasks_;
 
-//------------------------------------------------------------------------------
-//
-template <class Tp_, class... Args_>
-auto ThreadPool::Enqueue(Tp_ &&f, Args_ &&... args)
-    -> std::future<typename std::result_of<Tp_(Args_...)>::type> {
-  using return_type = typename std::result_of<Tp_(Args_...)>::type;
+  details::TaskQueue low_tasks_;
 
-  auto task = std::make_shared<std::packaged_task<return_type()>>(
-      std::bind(std::forward<Tp_>(f), std::forward<Args_>(args)...));
+  /**
+   * A min heap on the deadline of the tasks.
+   */
+  std::vector<DeadlineTask> deadline_tasks_;
 
-  std::future<return_type> res = task->get_future();
+  uint64_t deadline_sequence_;
 
-  {
-    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
 
-    if (is_stoped_) {
-      throw std::runtime_error("enqueue on stopped ThreadPool");
-    }
+  std::unique_ptr<details::MpmcQueue<Task>> ring_;
 
-    tasks_.emplace([task]() { (*task)(); });
-  }
+  /**
+   * The number of tasks waiting in any queue of the pool. This is what the
+   * idle workers are waiting on.
+   */
+  std::atomic<size_t> pending_tasks_;
 
-  condition_.notify_one();
-  return res;
-}
+  /**
+   * The number of tasks in the deadline queue and the high priority lane, so
+   * the workers of the work stealing backend can check the urgent tasks
+   * without taking the lock.
+   */
+  std::atomic<size_t> urgent_tasks_;
+
+  std::atomic<size_t> queued_low_tasks_;
+
+  std::atomic<uint64_t> deadline_task_count_;
+
+  std::atomic<uint64_t> late_start_count_;
+
+  std::atomic<uint64_t> deadline_miss_count_;
+
+  std::atomic<size_t> idle_workers_;
+
+  std::atomic<size_t> next_queue_;
+
+  /**
+   * The timers of the scheduled tasks, created on the first use.
+   */
+  std::unique_ptr<details::TimerQueue> timers_;
+
+  std::once_flag timers_flag_;
+
+  mutable std::mutex queue_mutex_;
+
+  std::condition_variable condition_;
+
+  std::atomic<bool> is_stoped_;
+};
 
 }  // namespace sonia_common
 
+#include <sonia_common/pattern/thread_pool_inl.h>
+
 #endif  // SONIA_COMMON_PATTERN_THREAD_POOL_H_
@@ -0,0 +1,1064 @@
+/**
+ * \file	thread_pool_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_PATTERN_THREAD_POOL_H_
+#error This file may only be included from thread_pool.h
+#endif
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <system_error>
+
+namespace sonia_common {
+
+//==============================================================================
+// C / D T O R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::Options::Options() ATLAS_NOEXCEPT
+    : backend(Backend::kSharedQueue),
+      ring_capacity(4096),
+      spin_count(128),
+      thread_options(),
+      max_threads(0),
+      grow_queue_depth(2),
+      grow_wait_time(std::chrono::milliseconds(10)),
+      idle_timeout(std::chrono::seconds(5)) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::ThreadPool(size_t threads) ATLAS_NOEXCEPT
+    : ThreadPool(threads, Options()) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::ThreadPool(size_t threads, const Options &options)
+    : options_(options),
+      workers_(),
+      retired_workers_(),
+      min_workers_(threads),
+      active_workers_(threads),
+      busy_workers_(0),
+      last_start_(Clock::now().time_since_epoch().count()),
+      tasks_(),
+      high_tasks_(),
+      low_tasks_(),
+      deadline_tasks_(),
+      deadline_sequence_(0),
+      worker_queues_(),
+      ring_(),
+      pending_tasks_(0),
+      urgent_tasks_(0),
+      queued_low_tasks_(0),
+      deadline_task_count_(0),
+      late_start_count_(0),
+      deadline_miss_count_(0),
+      idle_workers_(0),
+      next_queue_(0),
+      timers_(),
+      timers_flag_(),
+      queue_mutex_(),
+      condition_(),
+      is_stoped_(false) {
+  if (options_.max_threads > threads &&
+      options_.backend == Backend::kWorkStealing) {
+    throw std::invalid_argument(
+        "elastic ThreadPool on the work stealing backend");
+  }
+
+  if (options_.backend == Backend::kWorkStealing) {
+    // Always keep one deque so a pool without any worker still accepts tasks
+    // like the shared queue backend does.
+    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+      worker_queues_.emplace_back(new WorkerQueue());
+    }
+  } else if (options_.backend == Backend::kLockFreeRing) {
+    ring_.reset(new details::MpmcQueue<Task>(options_.ring_capacity));
+  }
+
+#if defined(SONIA_THREAD_POOL_METRICS)
+  metrics_.reset(new MetricsState(std::max(threads, options_.max_threads)));
+#endif
+
+  std::vector<std::promise<void>> configured(threads);
+  std::vector<std::future<void>> results;
+  for (auto &promise : configured) {
+    results.push_back(promise.get_future());
+  }
+
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this, i, &configured] {
+      if (ConfigureWorker(i, configured[i])) {
+        Work(i);
+      }
+    });
+  }
+
+  std::exception_ptr error;
+  for (auto &result : results) {
+    try {
+      result.get();
+    } catch (...) {
+      error = std::current_exception();
+    }
+  }
+
+  if (error) {
+    // The destructor will not be called, stop the workers that did start.
+    {
+      auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+      is_stoped_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread &worker : workers_) {
+      worker.join();
+    }
+    std::rethrow_exception(error);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::~ThreadPool() ATLAS_NOEXCEPT {
+  if (timers_) {
+    timers_->Stop();
+  }
+  {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    is_stoped_ = true;
+  }
+  condition_.notify_all();
+  for (std::thread &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TimerHandle::TimerHandle() ATLAS_NOEXCEPT : entry_() {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TimerHandle::TimerHandle(
+    const std::shared_ptr<details::TimerEntry> &entry) ATLAS_NOEXCEPT
+    : entry_(entry) {}
+
+#if defined(SONIA_THREAD_POOL_METRICS)
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::MetricsState::MetricsState(size_t workers)
+    : start(Clock::now().time_since_epoch().count()),
+      wait_time(),
+      run_time(),
+      queue_high_water_mark(0),
+      worker_busy_time(workers) {
+  for (auto &busy_time : worker_busy_time) {
+    busy_time = 0;
+  }
+}
+#endif
+
+//------------------------------------------------------------------------------
+//
+template <class Index_, class Body_>
+ATLAS_INLINE ThreadPool::ParallelState<Index_, Body_>::ParallelState(
+    Index_ grain, Body_ &body)
+    : grain(grain), body(body), pending(0), failed(false), error() {}
+
+//==============================================================================
+// O P E R A T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::LaterDeadline::operator()(
+    const DeadlineTask &lhs, const DeadlineTask &rhs) const {
+  if (lhs.deadline != rhs.deadline) {
+    return lhs.deadline > rhs.deadline;
+  }
+  return lhs.sequence > rhs.sequence;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class... Args_>
+auto ThreadPool::Enqueue(Tp_ &&f, Args_ &&... args)
+    -> std::future<typename std::result_of<Tp_(Args_...)>::type> {
+  auto task = Package(std::forward<Tp_>(f), std::forward<Args_>(args)...);
+  auto res = task.get_future();
+  Push(Task(std::move(task)));
+  return res;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class... Args_>
+auto ThreadPool::EnqueueWithPriority(Priority priority, Tp_ &&f,
+                                     Args_ &&... args)
+    -> std::future<typename std::result_of<Tp_(Args_...)>::type> {
+  auto task = Package(std::forward<Tp_>(f), std::forward<Args_>(args)...);
+  auto res = task.get_future();
+  if (priority == Priority::kNormal) {
+    Push(Task(std::move(task)));
+  } else {
+    PushToLane(priority, Task(std::move(task)));
+  }
+  return res;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class... Args_>
+auto ThreadPool::EnqueueWithDeadline(Clock::time_point deadline, Tp_ &&f,
+                                     Args_ &&... args)
+    -> std::future<typename std::result_of<Tp_(Args_...)>::type> {
+  auto task = Package(std::forward<Tp_>(f), std::forward<Args_>(args)...);
+  auto res = task.get_future();
+  PushWithDeadline(deadline, Task(std::move(task)));
+  return res;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class... Args_>
+auto ThreadPool::Package(Tp_ &&f, Args_ &&... args)
+    -> std::packaged_task<typename std::result_of<Tp_(Args_...)>::type()> {
+  // The packaged_task is moved in the Task, the only allocation left is the
+  // shared state of the future.
+  return std::packaged_task<typename std::result_of<Tp_(Args_...)>::type()>(
+      std::bind(std::forward<Tp_>(f), std::forward<Args_>(args)...));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void ThreadPool::EnqueueDetached(Tp_ &&f) {
+  Push(Task(std::forward<Tp_>(f)));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_, class Arg_, class... Args_>
+ATLAS_INLINE void ThreadPool::EnqueueDetached(Tp_ &&f, Arg_ &&arg,
+                                              Args_ &&... args) {
+  Push(Task(std::bind(std::forward<Tp_>(f), std::forward<Arg_>(arg),
+                      std::forward<Args_>(args)...)));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_>
+ATLAS_INLINE ThreadPool::TimerHandle ThreadPool::ScheduleAt(
+    Clock::time_point deadline, Fp_ &&f) {
+  return Schedule(deadline, Clock::duration::zero(),
+                  std::function<void()>(std::forward<Fp_>(f)));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_>
+ATLAS_INLINE ThreadPool::TimerHandle ThreadPool::ScheduleAfter(
+    Clock::duration delay, Fp_ &&f) {
+  return ScheduleAt(Clock::now() + delay, std::forward<Fp_>(f));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Fp_>
+ATLAS_INLINE ThreadPool::TimerHandle ThreadPool::ScheduleEvery(
+    Clock::duration period, Fp_ &&f) {
+  if (period <= Clock::duration::zero()) {
+    throw std::invalid_argument("the period must be positive");
+  }
+  return Schedule(Clock::now() + period, period,
+                  std::function<void()>(std::forward<Fp_>(f)));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_, class Fp_>
+ATLAS_INLINE void ThreadPool::ParallelFor(Index_ begin, Index_ end,
+                                          Index_ grain, Fp_ &&f) {
+  auto body = [&f](Index_ chunk_begin, Index_ chunk_end) {
+    for (Index_ i = chunk_begin; i < chunk_end; ++i) {
+      f(i);
+    }
+  };
+  RunParallel(begin, end, grain, body);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_, class Tp_, class Mp_, class Rp_>
+ATLAS_INLINE Tp_ ThreadPool::ParallelReduce(Index_ begin, Index_ end,
+                                            Index_ grain, Tp_ identity,
+                                            Mp_ &&map, Rp_ &&reduce) {
+  Tp_ result = identity;
+  std::mutex result_mutex;
+  auto body = [&](Index_ chunk_begin, Index_ chunk_end) {
+    Tp_ partial = identity;
+    for (Index_ i = chunk_begin; i < chunk_end; ++i) {
+      partial = reduce(partial, map(i));
+    }
+    std::lock_guard<std::mutex> lock(result_mutex);
+    result = reduce(result, partial);
+  };
+  RunParallel(begin, end, grain, body);
+  return result;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_, class Body_>
+ATLAS_INLINE void ThreadPool::RunParallel(Index_ begin, Index_ end,
+                                          Index_ grain, Body_ &body) {
+  if (!(begin < end)) {
+    return;
+  }
+
+  if (!(Index_(0) < grain)) {
+    // A few chunks per thread, counting the caller, is enough for the
+    // stealing to even out the load without paying for too many tasks.
+    grain = std::max<Index_>(
+        Index_(1), static_cast<Index_>((end - begin) / (4 * (Size() + 1))));
+  }
+
+  ParallelState<Index_, Body_> state(grain, body);
+  state.pending = 1;
+  RunChunk(&state, begin, end);
+
+  while (state.pending > 0) {
+    if (!RunPendingTask()) {
+      std::this_thread::yield();
+    }
+  }
+
+  if (state.error) {
+    std::rethrow_exception(state.error);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Index_, class Body_>
+ATLAS_INLINE void ThreadPool::RunChunk(ParallelState<Index_, Body_> *state,
+                                       Index_ begin, Index_ end) {
+  while (end - begin > state->grain) {
+    Index_ middle = begin + (end - begin) / 2;
+    ++state->pending;
+    try {
+      EnqueueDetached(
+          [this, state, middle, end] { RunChunk(state, middle, end); });
+    } catch (...) {
+      // The pool is stopping or out of memory: run the rest here instead.
+      --state->pending;
+      break;
+    }
+    end = middle;
+  }
+
+  if (!state->failed) {
+    try {
+      state->body(begin, end);
+    } catch (...) {
+      if (!state->failed.exchange(true)) {
+        state->error = std::current_exception();
+      }
+    }
+  }
+
+  // This must be the last access to the state: the caller may return as
+  // soon as it sees the counter reach zero.
+  --state->pending;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::RunPendingTask() {
+  const WorkerContext &context = CurrentWorker();
+  const size_t index =
+      context.pool == this ? context.index : worker_queues_.size();
+
+  Task task;
+  Clock::time_point deadline;
+  if (!PopTask(index, task, deadline)) {
+    return false;
+  }
+  Run(task, deadline);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::DeadlineStatistics ThreadPool::GetDeadlineStatistics()
+    const ATLAS_NOEXCEPT {
+  DeadlineStatistics statistics;
+  statistics.tasks = deadline_task_count_;
+  statistics.late_starts = late_start_count_;
+  statistics.misses = deadline_miss_count_;
+  return statistics;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ThreadPool::Size() const ATLAS_NOEXCEPT {
+  return active_workers_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE double ThreadPool::GetUtilization() const ATLAS_NOEXCEPT {
+  const size_t active = active_workers_;
+  if (active == 0) {
+    return 0.;
+  }
+  return std::min(1., static_cast<double>(busy_workers_) / active);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::Backend ThreadPool::GetBackend() const ATLAS_NOEXCEPT {
+  return options_.backend;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::IsWorkerThread() const ATLAS_NOEXCEPT {
+  return CurrentWorker().pool == this;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::TimerHandle::Cancel() ATLAS_NOEXCEPT {
+  if (entry_) {
+    entry_->cancelled = true;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::TimerHandle::IsCancelled() const ATLAS_NOEXCEPT {
+  return entry_ && entry_->cancelled;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TimerStatistics
+ThreadPool::TimerHandle::GetStatistics() const ATLAS_NOEXCEPT {
+  TimerStatistics statistics = {0, 0, Clock::duration::zero(),
+                                Clock::duration::zero(),
+                                Clock::duration::zero()};
+  if (entry_) {
+    statistics.firings = entry_->firings;
+    statistics.skipped = entry_->skipped;
+    statistics.last_lateness = Clock::duration(entry_->last_lateness);
+    statistics.max_lateness = Clock::duration(entry_->max_lateness);
+    statistics.total_lateness = Clock::duration(entry_->total_lateness);
+  }
+  return statistics;
+}
+
+//------------------------------------------------------------------------------
+//
+constexpr bool ThreadPool::HasMetrics() ATLAS_NOEXCEPT {
+#if defined(SONIA_THREAD_POOL_METRICS)
+  return true;
+#else
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::Metrics ThreadPool::GetMetrics() const {
+  Metrics metrics;
+  metrics.elapsed = Clock::duration::zero();
+  metrics.queue_high_water_mark = 0;
+#if defined(SONIA_THREAD_POOL_METRICS)
+  metrics.elapsed =
+      Clock::now().time_since_epoch() - Clock::duration(metrics_->start);
+  metrics.wait_time = metrics_->wait_time.GetSnapshot();
+  metrics.run_time = metrics_->run_time.GetSnapshot();
+  metrics.queue_high_water_mark = metrics_->queue_high_water_mark;
+  const double elapsed = std::max<Clock::rep>(metrics.elapsed.count(), 1);
+  for (auto &busy_time : metrics_->worker_busy_time) {
+    metrics.worker_busy_ratio.push_back(busy_time / elapsed);
+  }
+#endif
+  return metrics;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::ResetMetrics() ATLAS_NOEXCEPT {
+#if defined(SONIA_THREAD_POOL_METRICS)
+  metrics_->start = Clock::now().time_since_epoch().count();
+  metrics_->wait_time.Reset();
+  metrics_->run_time.Reset();
+  metrics_->queue_high_water_mark = pending_tasks_.load();
+  for (auto &busy_time : metrics_->worker_busy_time) {
+    busy_time = 0;
+  }
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::WorkerContext &ThreadPool::CurrentWorker()
+    ATLAS_NOEXCEPT {
+  static thread_local WorkerContext context = {nullptr, 0};
+  return context;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::Push(Task &&task) {
+  if (is_stoped_) {
+    throw std::runtime_error("enqueue on stopped ThreadPool");
+  }
+
+  StampEnqueue(task);
+  switch (options_.backend) {
+    case Backend::kWorkStealing:
+      PushWorkStealing(std::move(task));
+      break;
+    case Backend::kLockFreeRing:
+      PushLockFree(std::move(task));
+      break;
+    default:
+      PushShared(std::move(task));
+      break;
+  }
+  RecordQueueDepth();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::TimerHandle ThreadPool::Schedule(
+    Clock::time_point deadline, Clock::duration period,
+    std::function<void()> task) {
+  if (is_stoped_) {
+    throw std::runtime_error("schedule on stopped ThreadPool");
+  }
+  std::call_once(timers_flag_, [this] {
+    timers_.reset(new details::TimerQueue(
+        [this](Task &&firing) { Push(std::move(firing)); }));
+  });
+
+  auto entry = std::make_shared<details::TimerEntry>(std::move(task), period);
+  timers_->Schedule(deadline, entry);
+  return TimerHandle(entry);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::PushShared(Task &&task) {
+  {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+
+    if (is_stoped_) {
+      throw std::runtime_error("enqueue on stopped ThreadPool");
+    }
+
+    tasks_.PushBack(std::move(task));
+    ++pending_tasks_;
+  }
+
+  condition_.notify_one();
+  GrowIfNeeded();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::PushWorkStealing(Task &&task) {
+  const WorkerContext &context = CurrentWorker();
+  size_t index = context.pool == this
+                     ? context.index
+                     : next_queue_.fetch_add(1) % worker_queues_.size();
+
+  // The counter is raised before the task is visible so it never goes below
+  // the real number of queued tasks.
+  ++pending_tasks_;
+  {
+    WorkerQueue &queue = *worker_queues_[index];
+    auto lock = std::unique_lock<std::mutex>{queue.mutex};
+    queue.tasks.PushBack(std::move(task));
+  }
+
+  NotifyIdleWorker();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::PushLockFree(Task &&task) {
+  const bool is_worker = CurrentWorker().pool == this;
+
+  ++pending_tasks_;
+  while (!ring_->TryPush(std::move(task))) {
+    // A worker blocking on a full ring could dead lock the pool, make
+    // progress on the queued tasks instead.
+    if (!is_worker || !RunPendingTask()) {
+      std::this_thread::yield();
+    }
+  }
+
+  NotifyIdleWorker();
+  GrowIfNeeded();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::NotifyIdleWorker() {
+  // A worker registers itself as idle before checking pending_tasks_, so if
+  // we do not see it here, it will see our task and will not go to sleep.
+  if (idle_workers_ > 0) {
+    { auto lock = std::unique_lock<std::mutex>{queue_mutex_}; }
+    condition_.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::PushToLane(Priority priority, Task &&task) {
+  StampEnqueue(task);
+  {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+
+    if (is_stoped_) {
+      throw std::runtime_error("enqueue on stopped ThreadPool");
+    }
+
+    if (priority == Priority::kHigh) {
+      high_tasks_.PushBack(std::move(task));
+      ++urgent_tasks_;
+    } else {
+      low_tasks_.PushBack(std::move(task));
+      ++queued_low_tasks_;
+    }
+    ++pending_tasks_;
+  }
+
+  condition_.notify_one();
+  RecordQueueDepth();
+  GrowIfNeeded();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::PushWithDeadline(Clock::time_point deadline,
+                                               Task &&task) {
+  StampEnqueue(task);
+  {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+
+    if (is_stoped_) {
+      throw std::runtime_error("enqueue on stopped ThreadPool");
+    }
+
+    deadline_tasks_.push_back(
+        DeadlineTask{deadline, deadline_sequence_++, std::move(task)});
+    std::push_heap(deadline_tasks_.begin(), deadline_tasks_.end(),
+                   LaterDeadline());
+    ++urgent_tasks_;
+    ++pending_tasks_;
+  }
+
+  condition_.notify_one();
+  RecordQueueDepth();
+  GrowIfNeeded();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::ConfigureWorker(size_t index,
+                                              std::promise<void> &configured) {
+  ThreadOptions thread_options = options_.thread_options;
+  if (!thread_options.name.empty()) {
+    // Keep the index visible when the name gets truncated by the kernel.
+    std::string suffix = "/" + std::to_string(index);
+    thread_options.name =
+        thread_options.name.substr(0, 15 - std::min<size_t>(suffix.size(), 15)) +
+        suffix;
+  }
+
+  try {
+    ApplyThreadOptions(thread_options);
+  } catch (...) {
+    configured.set_exception(std::current_exception());
+    return false;
+  }
+  configured.set_value();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::Work(size_t index) {
+  CurrentWorker() = WorkerContext{this, index};
+
+  if (options_.backend == Backend::kSharedQueue) {
+    SharedQueueLoop(index);
+  } else {
+    WorkerLoop(index);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::SharedQueueLoop(size_t index) {
+  for (;;) {
+    Task task;
+    Clock::time_point deadline;
+
+    {
+      auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+      if (!WaitForTask(lock, index)) {
+        return;
+      }
+      PopSharedTask(task, deadline);
+    }
+
+    RunOnWorker(index, task, deadline);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::WorkerLoop(size_t index) {
+  size_t spins = 0;
+  for (;;) {
+    Task task;
+    Clock::time_point deadline;
+
+    if (PopTask(index, task, deadline)) {
+      RunOnWorker(index, task, deadline);
+      spins = 0;
+      continue;
+    }
+
+    if (spins < options_.spin_count && !is_stoped_) {
+      ++spins;
+      details::CpuRelax();
+      continue;
+    }
+    spins = 0;
+
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    if (!WaitForTask(lock, index)) {
+      return;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::WaitForTask(std::unique_lock<std::mutex> &lock,
+                                          size_t index) {
+  auto has_work = [this] { return is_stoped_ || pending_tasks_ > 0; };
+
+  ++idle_workers_;
+  if (options_.max_threads <= min_workers_) {
+    condition_.wait(lock, has_work);
+  } else {
+    while (!condition_.wait_for(lock, options_.idle_timeout, has_work)) {
+      if (active_workers_ > min_workers_) {
+        --idle_workers_;
+        --active_workers_;
+        retired_workers_.push_back(index);
+        return false;
+      }
+    }
+  }
+  --idle_workers_;
+
+  return !is_stoped_ || pending_tasks_ > 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::GrowIfNeeded() {
+  if (options_.max_threads <= min_workers_ ||
+      active_workers_ >= options_.max_threads) {
+    return;
+  }
+
+  // An idle worker may not have taken the tasks it has been woken up for
+  // yet, only the tasks beyond the idle workers are waiting for one.
+  const size_t pending = pending_tasks_;
+  const size_t idle = idle_workers_;
+  if (pending <= idle) {
+    return;
+  }
+  if (pending - idle <= options_.grow_queue_depth * active_workers_) {
+    auto since_start = Clock::now().time_since_epoch() -
+                       Clock::duration(last_start_.load());
+    if (since_start < options_.grow_wait_time) {
+      return;
+    }
+  }
+  AddWorker();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::AddWorker() {
+  auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+  if (is_stoped_ || active_workers_ >= options_.max_threads) {
+    return;
+  }
+
+  size_t index = workers_.size();
+  if (!retired_workers_.empty()) {
+    index = retired_workers_.back();
+    retired_workers_.pop_back();
+    // The retired worker does not need the lock to exit.
+    if (workers_[index].joinable()) {
+      workers_[index].join();
+    }
+  } else {
+    workers_.emplace_back();
+  }
+
+  ++active_workers_;
+  try {
+    workers_[index] = std::thread([this, index] {
+      std::promise<void> configured;
+      if (ConfigureWorker(index, configured)) {
+        Work(index);
+      } else {
+        auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+        --active_workers_;
+        retired_workers_.push_back(index);
+      }
+    });
+  } catch (const std::system_error &) {
+    // Out of threads, the pool keeps its current size.
+    --active_workers_;
+    retired_workers_.push_back(index);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::PopTask(size_t index, Task &task,
+                                      Clock::time_point &deadline) {
+  deadline = Clock::time_point::max();
+
+  if (options_.backend == Backend::kSharedQueue) {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    return PopSharedTask(task, deadline);
+  }
+
+  if (urgent_tasks_ > 0) {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    if (PopUrgentTask(task, deadline)) {
+      return true;
+    }
+  }
+
+  if (options_.backend == Backend::kLockFreeRing) {
+    if (ring_->TryPop(task)) {
+      --pending_tasks_;
+      return true;
+    }
+  } else if ((index < worker_queues_.size() && PopLocalTask(index, task)) ||
+             StealTask(index, task)) {
+    return true;
+  }
+
+  if (queued_low_tasks_ > 0) {
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    if (!low_tasks_.Empty()) {
+      low_tasks_.PopFront(task);
+      --queued_low_tasks_;
+      --pending_tasks_;
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::PopSharedTask(Task &task,
+                                            Clock::time_point &deadline) {
+  deadline = Clock::time_point::max();
+
+  if (PopUrgentTask(task, deadline)) {
+    return true;
+  }
+
+  details::TaskQueue *lane = !tasks_.Empty()
+                                 ? &tasks_
+                                 : (!low_tasks_.Empty() ? &low_tasks_ : nullptr);
+  if (lane == nullptr) {
+    return false;
+  }
+  lane->PopFront(task);
+  if (lane == &low_tasks_) {
+    --queued_low_tasks_;
+  }
+  --pending_tasks_;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::PopUrgentTask(Task &task,
+                                            Clock::time_point &deadline) {
+  if (!deadline_tasks_.empty()) {
+    std::pop_heap(deadline_tasks_.begin(), deadline_tasks_.end(),
+                  LaterDeadline());
+    deadline = deadline_tasks_.back().deadline;
+    task = std::move(deadline_tasks_.back().task);
+    deadline_tasks_.pop_back();
+  } else if (!high_tasks_.Empty()) {
+    high_tasks_.PopFront(task);
+  } else {
+    return false;
+  }
+  --urgent_tasks_;
+  --pending_tasks_;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::PopLocalTask(size_t index, Task &task) {
+  WorkerQueue &queue = *worker_queues_[index];
+  auto lock = std::unique_lock<std::mutex>{queue.mutex};
+  if (queue.tasks.Empty()) {
+    return false;
+  }
+  queue.tasks.PopBack(task);
+  --pending_tasks_;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::StealTask(size_t index, Task &task) {
+  // An index out of the range of the queues, as used by the threads that are
+  // not workers, makes every queue a potential victim.
+  const size_t count = worker_queues_.size();
+  for (size_t i = 1; i <= count; ++i) {
+    const size_t victim_index = (index + i) % count;
+    if (victim_index == index) {
+      continue;
+    }
+    WorkerQueue &victim = *worker_queues_[victim_index];
+    auto lock = std::unique_lock<std::mutex>{victim.mutex, std::try_to_lock};
+    if (!lock.owns_lock() || victim.tasks.Empty()) {
+      continue;
+    }
+    victim.tasks.PopFront(task);
+    --pending_tasks_;
+    return true;
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::Run(Task &task,
+                                   Clock::time_point deadline) ATLAS_NOEXCEPT {
+  if (options_.max_threads > min_workers_) {
+    last_start_ = Clock::now().time_since_epoch().count();
+  }
+#if defined(SONIA_THREAD_POOL_METRICS)
+  const auto start = Clock::now();
+  metrics_->wait_time.Record(start - task.GetEnqueueTime());
+#endif
+
+  const bool has_deadline = deadline != Clock::time_point::max();
+  if (has_deadline) {
+    ++deadline_task_count_;
+    if (Clock::now() > deadline) {
+      ++late_start_count_;
+    }
+  }
+
+  // The tasks created by Enqueue() store their exception in the future, only
+  // the detached ones can reach this point and they must not kill the worker.
+  try {
+    task();
+  } catch (...) {
+  }
+  task.Reset();
+#if defined(SONIA_THREAD_POOL_METRICS)
+  metrics_->run_time.Record(Clock::now() - start);
+#endif
+
+  if (has_deadline && Clock::now() > deadline) {
+    ++deadline_miss_count_;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::RunOnWorker(
+    size_t index, Task &task, Clock::time_point deadline) ATLAS_NOEXCEPT {
+  ++busy_workers_;
+#if defined(SONIA_THREAD_POOL_METRICS)
+  const auto start = Clock::now();
+  Run(task, deadline);
+  metrics_->worker_busy_time[index] += (Clock::now() - start).count();
+#else
+  (void)index;
+  Run(task, deadline);
+#endif
+  --busy_workers_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void ThreadPool::StampEnqueue(Task &task) const
+    ATLAS_NOEXCEPT {
+#if defined(SONIA_THREAD_POOL_METRICS)
+  task.SetEnqueueTime(Clock::now());
+#else
+  (void)task;
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void ThreadPool::RecordQueueDepth() ATLAS_NOEXCEPT {
+#if defined(SONIA_THREAD_POOL_METRICS)
+  const size_t depth = pending_tasks_;
+  size_t mark = metrics_->queue_high_water_mark;
+  while (depth > mark &&
+         !metrics_->queue_high_water_mark.compare_exchange_weak(mark, depth)) {
+  }
+#endif
+}
+
+}  // namespace sonia_common
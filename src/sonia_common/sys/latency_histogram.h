@@ -0,0 +1,212 @@
+/**
+ * \file	latency_histogram.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_SYSTEM_LATENCY_HISTOGRAM_H_
+#define SONIA_COMMON_SYSTEM_LATENCY_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/sys/timer.h>
+
+namespace sonia_common {
+
+/**
+ * A histogram of latencies in fixed memory, in the manner of HdrHistogram.
+ *
+ * The buckets are log-linear: the durations up to 32 ticks of the Clock have
+ * a bucket each, then every power of two is split in 32 buckets of the same
+ * width. Any duration is so counted with an error under 1 / 32 of its
+ * value, about 3 %, from a nanosecond to centuries, in 1920 buckets.
+ *
+ * Recording is O(1), without allocation nor lock: a handful of relaxed
+ * atomic operations, so any number of threads can record in the same
+ * histogram. Histograms recorded separately, for example one per thread,
+ * can also be merged. A snapshot taken while other threads record is not
+ * perfectly consistent, but every count in it is exact.
+ */
+class LatencyHistogram {
+ public:
+  //============================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Clock = std::chrono::steady_clock;
+
+  enum : size_t {
+    kSubBucketBits = 5,
+    kSubBuckets = size_t(1) << kSubBucketBits,
+    kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets
+  };
+
+  /**
+   * A copy of the histogram, to compute the statistics from.
+   */
+  struct Snapshot {
+    Snapshot() ATLAS_NOEXCEPT;
+
+    /**
+     * \return The duration under which the given fraction of the samples
+     *         are, rounded up to the end of its bucket, e.g.
+     *         Percentile(0.999) for the p99.9.
+     */
+    Clock::duration Percentile(double fraction) const ATLAS_NOEXCEPT;
+
+    Clock::duration Mean() const ATLAS_NOEXCEPT;
+
+    void Merge(const Snapshot &other) ATLAS_NOEXCEPT;
+
+    uint64_t count;
+
+    Clock::duration total;
+
+    /**
+     * Zero when there is no sample.
+     */
+    Clock::duration min;
+
+    Clock::duration max;
+
+    /**
+     * The number of samples in each bucket, see LowerBound() and
+     * UpperBound().
+     */
+    std::array<uint64_t, kBuckets> buckets;
+  };
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  LatencyHistogram() ATLAS_NOEXCEPT;
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * Count a duration, the negative ones as zero.
+   */
+  void Record(Clock::duration duration) ATLAS_NOEXCEPT;
+
+  /**
+   * Count a duration given in ticks of the Clock.
+   */
+  void RecordTicks(uint64_t ticks) ATLAS_NOEXCEPT;
+
+  /**
+   * Add the samples of the other histogram to this one.
+   */
+  void Merge(const LatencyHistogram &other) ATLAS_NOEXCEPT;
+
+  void Reset() ATLAS_NOEXCEPT;
+
+  Snapshot GetSnapshot() const ATLAS_NOEXCEPT;
+
+  uint64_t Count() const ATLAS_NOEXCEPT;
+
+  Clock::duration Max() const ATLAS_NOEXCEPT;
+
+  /**
+   * A shortcut for GetSnapshot().Percentile(fraction).
+   */
+  Clock::duration Percentile(double fraction) const ATLAS_NOEXCEPT;
+
+  static size_t BucketOf(uint64_t ticks) ATLAS_NOEXCEPT;
+
+  /**
+   * \return The smallest number of ticks counted in the bucket.
+   */
+  static uint64_t LowerBound(size_t bucket) ATLAS_NOEXCEPT;
+
+  /**
+   * \return The largest number of ticks counted in the bucket.
+   */
+  static uint64_t UpperBound(size_t bucket) ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void Add(size_t bucket, uint64_t count, uint64_t total, uint64_t min,
+           uint64_t max) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::atomic<uint64_t> buckets_[kBuckets];
+
+  std::atomic<uint64_t> count_;
+
+  std::atomic<uint64_t> total_;
+
+  std::atomic<uint64_t> min_;
+
+  std::atomic<uint64_t> max_;
+};
+
+/**
+ * Records the lifetime of the scope in a LatencyHistogram, measured with a
+ * LocalTimer.
+ *
+ * Sample usage:
+ *
+ * void Filter::Apply(cv::Mat &image) {
+ *   ScopedLatency latency(apply_latency_);
+ *   ...
+ * }
+ */
+class ScopedLatency {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit ScopedLatency(LatencyHistogram &histogram) ATLAS_NOEXCEPT;
+
+  ~ScopedLatency() ATLAS_NOEXCEPT;
+
+  ScopedLatency(const ScopedLatency &) = delete;
+
+  ScopedLatency &operator=(const ScopedLatency &) = delete;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  LatencyHistogram &histogram_;
+
+  LocalTimer<LatencyHistogram::Clock> timer_;
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/sys/latency_histogram_inl.h>
+
+#endif  // SONIA_COMMON_SYSTEM_LATENCY_HISTOGRAM_H_
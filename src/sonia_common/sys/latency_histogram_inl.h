@@ -0,0 +1,266 @@
+/**
+ * \file	latency_histogram_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_SYSTEM_LATENCY_HISTOGRAM_H_
+#error This file may only be included from latency_histogram.h
+#endif
+
+#include <algorithm>
+#include <limits>
+
+namespace sonia_common {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LatencyHistogram::Snapshot::Snapshot() ATLAS_NOEXCEPT
+    : count(0),
+      total(Clock::duration::zero()),
+      min(Clock::duration::zero()),
+      max(Clock::duration::zero()),
+      buckets() {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LatencyHistogram::LatencyHistogram() ATLAS_NOEXCEPT
+    : count_(0),
+      total_(0),
+      min_(std::numeric_limits<uint64_t>::max()),
+      max_(0) {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE ScopedLatency::ScopedLatency(LatencyHistogram &histogram)
+    ATLAS_NOEXCEPT : histogram_(histogram),
+                     timer_() {
+  timer_.Start();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE ScopedLatency::~ScopedLatency() ATLAS_NOEXCEPT {
+  histogram_.Record(timer_.Elapsed());
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LatencyHistogram::Clock::duration
+LatencyHistogram::Snapshot::Percentile(double fraction) const ATLAS_NOEXCEPT {
+  const double rank = std::min(std::max(fraction, 0.0), 1.0) * count;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (buckets[i] > 0 && seen >= rank) {
+      return std::min(Clock::duration(static_cast<Clock::rep>(UpperBound(i))),
+                      max);
+    }
+  }
+  return max;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LatencyHistogram::Clock::duration
+LatencyHistogram::Snapshot::Mean() const ATLAS_NOEXCEPT {
+  return count == 0 ? Clock::duration::zero()
+                    : total / static_cast<Clock::rep>(count);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void LatencyHistogram::Snapshot::Merge(const Snapshot &other)
+    ATLAS_NOEXCEPT {
+  if (other.count == 0) {
+    return;
+  }
+  min = count == 0 ? other.min : std::min(min, other.min);
+  max = std::max(max, other.max);
+  count += other.count;
+  total += other.total;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    buckets[i] += other.buckets[i];
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void LatencyHistogram::Record(Clock::duration duration)
+    ATLAS_NOEXCEPT {
+  RecordTicks(duration.count() < 0 ? 0
+                                   : static_cast<uint64_t>(duration.count()));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void LatencyHistogram::RecordTicks(uint64_t ticks)
+    ATLAS_NOEXCEPT {
+  Add(BucketOf(ticks), 1, ticks, ticks, ticks);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void LatencyHistogram::Merge(const LatencyHistogram &other)
+    ATLAS_NOEXCEPT {
+  const uint64_t count = other.count_.load(std::memory_order_relaxed);
+  if (count == 0) {
+    return;
+  }
+  for (size_t i = 0; i < kBuckets; ++i) {
+    const uint64_t bucket = other.buckets_[i].load(std::memory_order_relaxed);
+    if (bucket != 0) {
+      buckets_[i].fetch_add(bucket, std::memory_order_relaxed);
+    }
+  }
+  // The buckets are already counted, only the summary is left to add.
+  Add(kBuckets, count, other.total_.load(std::memory_order_relaxed),
+      other.min_.load(std::memory_order_relaxed),
+      other.max_.load(std::memory_order_relaxed));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void LatencyHistogram::Reset() ATLAS_NOEXCEPT {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  total_.store(0, std::memory_order_relaxed);
+  min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const
+    ATLAS_NOEXCEPT {
+  Snapshot snapshot;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    snapshot.count += snapshot.buckets[i];
+  }
+  if (snapshot.count == 0) {
+    return snapshot;
+  }
+  // The count of the buckets, rather than count_, so the percentiles add up
+  // when other threads record meanwhile.
+  snapshot.total = Clock::duration(
+      static_cast<Clock::rep>(total_.load(std::memory_order_relaxed)));
+  snapshot.min = Clock::duration(
+      static_cast<Clock::rep>(std::min(min_.load(std::memory_order_relaxed),
+                                       max_.load(std::memory_order_relaxed))));
+  snapshot.max = Max();
+  return snapshot;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE uint64_t LatencyHistogram::Count() const ATLAS_NOEXCEPT {
+  return count_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE LatencyHistogram::Clock::duration LatencyHistogram::Max()
+    const ATLAS_NOEXCEPT {
+  return Clock::duration(
+      static_cast<Clock::rep>(max_.load(std::memory_order_relaxed)));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LatencyHistogram::Clock::duration LatencyHistogram::Percentile(
+    double fraction) const ATLAS_NOEXCEPT {
+  return GetSnapshot().Percentile(fraction);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE size_t LatencyHistogram::BucketOf(uint64_t ticks)
+    ATLAS_NOEXCEPT {
+  if (ticks < kSubBuckets) {
+    return static_cast<size_t>(ticks);
+  }
+  // The magnitude selects a group of kSubBuckets buckets, and the bits right
+  // under the highest one select the bucket in the group.
+  const size_t group = 64 - kSubBucketBits - __builtin_clzll(ticks);
+  const uint64_t sub_bucket = ticks >> (group - 1);
+  return group * kSubBuckets + static_cast<size_t>(sub_bucket - kSubBuckets);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t LatencyHistogram::LowerBound(size_t bucket)
+    ATLAS_NOEXCEPT {
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  const size_t group = bucket / kSubBuckets;
+  const uint64_t sub_bucket = kSubBuckets + bucket % kSubBuckets;
+  return sub_bucket << (group - 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t LatencyHistogram::UpperBound(size_t bucket)
+    ATLAS_NOEXCEPT {
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  const size_t group = bucket / kSubBuckets;
+  return LowerBound(bucket) + ((uint64_t(1) << (group - 1)) - 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void LatencyHistogram::Add(size_t bucket, uint64_t count,
+                                               uint64_t total, uint64_t min,
+                                               uint64_t max) ATLAS_NOEXCEPT {
+  if (bucket < kBuckets) {
+    buckets_[bucket].fetch_add(count, std::memory_order_relaxed);
+  }
+  count_.fetch_add(count, std::memory_order_relaxed);
+  total_.fetch_add(total, std::memory_order_relaxed);
+  uint64_t current = min_.load(std::memory_order_relaxed);
+  while (min < current &&
+         !min_.compare_exchange_weak(current, min,
+                                     std::memory_order_relaxed)) {
+  }
+  current = max_.load(std::memory_order_relaxed);
+  while (max > current &&
+         !max_.compare_exchange_weak(current, max,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace sonia_common
@@ -0,0 +1,107 @@
+/**
+ * \file	thread_options.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_SYSTEM_THREAD_OPTIONS_H_
+#define SONIA_COMMON_SYSTEM_THREAD_OPTIONS_H_
+
+#include <pthread.h>
+#include <sched.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <sonia_common/macros.h>
+
+namespace sonia_common {
+
+/**
+ * The scheduling properties of a thread: the cores it may run on, its
+ * scheduling policy and priority, and its name.
+ *
+ * The default values leave the thread as the system created it. These options
+ * are accepted by the ThreadPool and the Runnable classes and are applied by
+ * the thread itself before it runs any user code.
+ */
+struct ThreadOptions {
+  ThreadOptions() ATLAS_NOEXCEPT;
+
+  /**
+   * The cores the thread may run on. An empty list keeps the affinity
+   * inherited from the parent thread.
+   */
+  std::vector<int> cpus;
+
+  /**
+   * SCHED_OTHER, SCHED_FIFO or SCHED_RR. The real-time policies usually
+   * require the CAP_SYS_NICE capability or a matching RLIMIT_RTPRIO.
+   */
+  int policy;
+
+  /**
+   * The static priority of the thread, from 1 to 99 for the real-time
+   * policies. It must be 0 for SCHED_OTHER.
+   */
+  int priority;
+
+  /**
+   * The name of the thread as shown by top -H or gdb. It is truncated to the
+   * 15 characters allowed by the kernel. An empty name keeps the current one.
+   */
+  std::string name;
+};
+
+/**
+ * Apply the options on the calling thread.
+ *
+ * Throws a std::system_error if one of the options cannot be applied, for
+ * example a real-time policy without the required privileges or a core that
+ * does not exist.
+ */
+void ApplyThreadOptions(const ThreadOptions &options);
+
+/**
+ * Apply the options on the given thread, which may not be the calling one.
+ */
+void ApplyThreadOptions(pthread_t thread, const ThreadOptions &options);
+
+/**
+ * Prepare the process for latency-critical work.
+ *
+ * This locks the current and future pages of the process in RAM, stops the
+ * allocator from giving memory back to the system, and touches
+ * stack_prefault_size bytes of the calling thread stack so the later page
+ * faults do not happen in the control loop.
+ * Call it once from the main thread, after the big allocations are done.
+ *
+ * Throws a std::system_error if the memory cannot be locked, usually because
+ * RLIMIT_MEMLOCK is too low.
+ */
+void LockProcessMemory(size_t stack_prefault_size = 256 * 1024);
+
+}  // namespace sonia_common
+
+#include <sonia_common/sys/thread_options_inl.h>
+
+#endif  // SONIA_COMMON_SYSTEM_THREAD_OPTIONS_H_
@@ -0,0 +1,122 @@
+/**
+ * \file	thread_options_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_SYSTEM_THREAD_OPTIONS_H_
+#error This file may only be included from thread_options.h
+#endif
+
+#include <alloca.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+namespace sonia_common {
+
+//==============================================================================
+// C / D T O R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadOptions::ThreadOptions() ATLAS_NOEXCEPT : cpus(),
+                                                             policy(SCHED_OTHER),
+                                                             priority(0),
+                                                             name() {}
+
+//==============================================================================
+// F U N C T I O N S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ApplyThreadOptions(const ThreadOptions &options) {
+  ApplyThreadOptions(pthread_self(), options);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ApplyThreadOptions(pthread_t thread,
+                                     const ThreadOptions &options) {
+  if (!options.cpus.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : options.cpus) {
+      if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        throw std::system_error(EINVAL, std::system_category(),
+                                "Invalid core in the thread affinity");
+      }
+      CPU_SET(cpu, &cpu_set);
+    }
+    int error = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+    if (error != 0) {
+      throw std::system_error(error, std::system_category(),
+                              "Could not set the thread affinity");
+    }
+  }
+
+  if (options.policy != SCHED_OTHER || options.priority != 0) {
+    sched_param parameters;
+    std::memset(&parameters, 0, sizeof(parameters));
+    parameters.sched_priority = options.priority;
+    int error = pthread_setschedparam(thread, options.policy, &parameters);
+    if (error != 0) {
+      throw std::system_error(error, std::system_category(),
+                              "Could not set the thread scheduling policy");
+    }
+  }
+
+  if (!options.name.empty()) {
+    // The kernel limits the name to 16 characters, the null one included.
+    int error = pthread_setname_np(thread, options.name.substr(0, 15).c_str());
+    if (error != 0) {
+      throw std::system_error(error, std::system_category(),
+                              "Could not set the thread name");
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void LockProcessMemory(size_t stack_prefault_size) {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    throw std::system_error(errno, std::system_category(),
+                            "Could not lock the process memory");
+  }
+
+  // Freed memory stays in the process instead of going back to the system,
+  // where it would be faulted in again on the next allocation.
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+
+  if (stack_prefault_size > 0) {
+    volatile unsigned char *stack =
+        static_cast<volatile unsigned char *>(alloca(stack_prefault_size));
+    for (size_t i = 0; i < stack_prefault_size; i += 4096) {
+      stack[i] = 0;
+    }
+  }
+}
+
+}  // namespace sonia_common
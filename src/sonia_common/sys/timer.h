@@ -27,7 +27,9 @@
 #define SONIA_COMMON_SYSTEM_TIMER_H_
 
 #include <sonia_common/macros.h>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -187,6 +189,8 @@ class Timer {
 
   static timespec TimeSpecNow() ATLAS_NOEXCEPT;
 
+  typename Tp_::duration Elapsed() const ATLAS_NOEXCEPT;
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
@@ -201,6 +205,166 @@ class Timer {
   mutable std::mutex member_guard_ = {};
 };
 
+/**
+ * A Timer for a single thread, to measure latencies in tight loops.
+ *
+ * It has no lock and returns integer durations, so a reading costs about the
+ * same as reading the clock. It must not be shared between threads, use an
+ * AtomicTimer for that.
+ */
+template <class Tp_ = std::chrono::steady_clock>
+class LocalTimer {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<LocalTimer<Tp_>>;
+
+  using Clock = Tp_;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * The timer is created paused, with no elapsed time.
+   */
+  LocalTimer() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Start the timer from zero, whether it was running or not.
+   */
+  void Start() ATLAS_NOEXCEPT;
+
+  /**
+   * \throw std::logic_error if the timer is not running.
+   */
+  void Pause();
+
+  /**
+   * \throw std::logic_error if the timer is running.
+   */
+  void Unpause();
+
+  /**
+   * Set the elapsed time to zero without changing the running state.
+   */
+  void Reset() ATLAS_NOEXCEPT;
+
+  bool IsRunning() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The running time since the start, pauses excluded.
+   */
+  typename Tp_::duration Elapsed() const ATLAS_NOEXCEPT;
+
+  int64_t NanoSeconds() const ATLAS_NOEXCEPT;
+
+  int64_t MicroSeconds() const ATLAS_NOEXCEPT;
+
+  int64_t MilliSeconds() const ATLAS_NOEXCEPT;
+
+  int64_t Seconds() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  bool is_running_;
+
+  typename Tp_::time_point start_time_;
+
+  typename Tp_::time_point pause_time_;
+};
+
+/**
+ * A Timer that can be started, paused and read from several threads without
+ * lock.
+ *
+ * The whole state is a single atomic word: the start time while the timer
+ * runs, the elapsed time, encoded as a negative number, while it is paused.
+ * A reading is a relaxed load and a reading of the clock, Pause() and
+ * Unpause() are a compare and swap.
+ */
+template <class Tp_ = std::chrono::steady_clock>
+class AtomicTimer {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<AtomicTimer<Tp_>>;
+
+  using Clock = Tp_;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * The timer is created paused, with no elapsed time.
+   */
+  AtomicTimer() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Start the timer from zero, whether it was running or not.
+   */
+  void Start() ATLAS_NOEXCEPT;
+
+  /**
+   * \throw std::logic_error if the timer is not running.
+   */
+  void Pause();
+
+  /**
+   * \throw std::logic_error if the timer is running.
+   */
+  void Unpause();
+
+  /**
+   * Set the elapsed time to zero without changing the running state.
+   */
+  void Reset() ATLAS_NOEXCEPT;
+
+  bool IsRunning() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The running time since the start, pauses excluded.
+   */
+  typename Tp_::duration Elapsed() const ATLAS_NOEXCEPT;
+
+  int64_t NanoSeconds() const ATLAS_NOEXCEPT;
+
+  int64_t MicroSeconds() const ATLAS_NOEXCEPT;
+
+  int64_t MilliSeconds() const ATLAS_NOEXCEPT;
+
+  int64_t Seconds() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  static int64_t Ticks() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The state of a paused timer with the given elapsed ticks.
+   */
+  static int64_t Paused(int64_t elapsed) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /**
+   * The start time in ticks of the clock when positive, or the elapsed ticks
+   * e of a paused timer, stored as -e - 1.
+   */
+  std::atomic<int64_t> state_;
+};
+
 using SecTimer = Timer<std::chrono::seconds, std::chrono::steady_clock>;
 using MilliTimer = Timer<std::chrono::milliseconds, std::chrono::steady_clock>;
 using MicroTimer = Timer<std::chrono::microseconds, std::chrono::steady_clock>;
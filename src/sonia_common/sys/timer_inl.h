@@ -29,6 +29,7 @@
 
 #include <sonia_common/macros.h>
 #include <math.h>
+#include <stdexcept>
 #include <thread>
 #ifdef __MACH__
 #include <mach/clock.h>
@@ -189,7 +190,8 @@ ATLAS_ALWAYS_INLINE void Timer<Up_, Tp_>::Sleep(int64_t sleeping_time)
 template <class Up_, class Tp_>
 ATLAS_ALWAYS_INLINE int64_t
 Timer<Up_, Tp_>::NanoSeconds() const ATLAS_NOEXCEPT {
-  return static_cast<int64_t>(Time<std::chrono::nanoseconds>() * 1000000000);
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Elapsed())
+      .count();
 }
 
 //------------------------------------------------------------------------------
@@ -197,7 +199,8 @@ Timer<Up_, Tp_>::NanoSeconds() const ATLAS_NOEXCEPT {
 template <class Up_, class Tp_>
 ATLAS_ALWAYS_INLINE int64_t
 Timer<Up_, Tp_>::MicroSeconds() const ATLAS_NOEXCEPT {
-  return static_cast<int64_t>(Time<std::chrono::microseconds>() * 1000000);
+  return std::chrono::duration_cast<std::chrono::microseconds>(Elapsed())
+      .count();
 }
 
 //------------------------------------------------------------------------------
@@ -205,28 +208,29 @@ Timer<Up_, Tp_>::MicroSeconds() const ATLAS_NOEXCEPT {
 template <class Up_, class Tp_>
 ATLAS_ALWAYS_INLINE int64_t
 Timer<Up_, Tp_>::MilliSeconds() const ATLAS_NOEXCEPT {
-  return static_cast<int64_t>(Time<std::chrono::milliseconds>() * 1000);
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Elapsed())
+      .count();
 }
 
 //------------------------------------------------------------------------------
 //
 template <class Up_, class Tp_>
 ATLAS_ALWAYS_INLINE int64_t Timer<Up_, Tp_>::Seconds() const ATLAS_NOEXCEPT {
-  return static_cast<int64_t>(Time<std::chrono::seconds>());
+  return std::chrono::duration_cast<std::chrono::seconds>(Elapsed()).count();
 }
 
 //------------------------------------------------------------------------------
 //
 template <class Up_, class Tp_>
 ATLAS_ALWAYS_INLINE int64_t Timer<Up_, Tp_>::Minutes() const ATLAS_NOEXCEPT {
-  return static_cast<int64_t>(Time<std::chrono::minutes>() / 60);
+  return std::chrono::duration_cast<std::chrono::minutes>(Elapsed()).count();
 }
 
 //------------------------------------------------------------------------------
 //
 template <class Up_, class Tp_>
 ATLAS_ALWAYS_INLINE int64_t Timer<Up_, Tp_>::Hours() const ATLAS_NOEXCEPT {
-  return static_cast<int64_t>(Time<std::chrono::hours>() / 3600);
+  return std::chrono::duration_cast<std::chrono::hours>(Elapsed()).count();
 }
 
 //------------------------------------------------------------------------------
@@ -248,4 +252,229 @@ ATLAS_ALWAYS_INLINE timespec Timer<Up_, Tp_>::TimeSpecNow() ATLAS_NOEXCEPT {
   return time;
 }
 
+//------------------------------------------------------------------------------
+//
+template <class Up_, class Tp_>
+ATLAS_ALWAYS_INLINE typename Tp_::duration Timer<Up_, Tp_>::Elapsed() const
+    ATLAS_NOEXCEPT {
+  std::lock_guard<std::mutex> guard(member_guard_);
+  return is_running_ ? Tp_::now() - start_time_ : pause_time_ - start_time_;
+}
+
+//==============================================================================
+// L O C A L   T I M E R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE LocalTimer<Tp_>::LocalTimer() ATLAS_NOEXCEPT
+    : is_running_(false),
+      start_time_(),
+      pause_time_() {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void LocalTimer<Tp_>::Start() ATLAS_NOEXCEPT {
+  start_time_ = Tp_::now();
+  is_running_ = true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void LocalTimer<Tp_>::Pause() {
+  if (!is_running_) {
+    throw std::logic_error("The timer is not running");
+  }
+  pause_time_ = Tp_::now();
+  is_running_ = false;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void LocalTimer<Tp_>::Unpause() {
+  if (is_running_) {
+    throw std::logic_error("The timer is running");
+  }
+  start_time_ += Tp_::now() - pause_time_;
+  is_running_ = true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void LocalTimer<Tp_>::Reset() ATLAS_NOEXCEPT {
+  start_time_ = Tp_::now();
+  pause_time_ = start_time_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE bool LocalTimer<Tp_>::IsRunning() const ATLAS_NOEXCEPT {
+  return is_running_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE typename Tp_::duration LocalTimer<Tp_>::Elapsed() const
+    ATLAS_NOEXCEPT {
+  return is_running_ ? Tp_::now() - start_time_ : pause_time_ - start_time_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t LocalTimer<Tp_>::NanoSeconds() const
+    ATLAS_NOEXCEPT {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Elapsed())
+      .count();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t LocalTimer<Tp_>::MicroSeconds() const
+    ATLAS_NOEXCEPT {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Elapsed())
+      .count();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t LocalTimer<Tp_>::MilliSeconds() const
+    ATLAS_NOEXCEPT {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Elapsed())
+      .count();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t LocalTimer<Tp_>::Seconds() const ATLAS_NOEXCEPT {
+  return std::chrono::duration_cast<std::chrono::seconds>(Elapsed()).count();
+}
+
+//==============================================================================
+// A T O M I C   T I M E R   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE AtomicTimer<Tp_>::AtomicTimer() ATLAS_NOEXCEPT
+    : state_(Paused(0)) {}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void AtomicTimer<Tp_>::Start() ATLAS_NOEXCEPT {
+  state_.store(Ticks(), std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void AtomicTimer<Tp_>::Pause() {
+  int64_t state = state_.load(std::memory_order_relaxed);
+  do {
+    if (state < 0) {
+      throw std::logic_error("The timer is not running");
+    }
+  } while (!state_.compare_exchange_weak(state, Paused(Ticks() - state),
+                                         std::memory_order_relaxed));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void AtomicTimer<Tp_>::Unpause() {
+  int64_t state = state_.load(std::memory_order_relaxed);
+  do {
+    if (state >= 0) {
+      throw std::logic_error("The timer is running");
+    }
+  } while (!state_.compare_exchange_weak(state, Ticks() - Paused(state),
+                                         std::memory_order_relaxed));
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void AtomicTimer<Tp_>::Reset() ATLAS_NOEXCEPT {
+  int64_t state = state_.load(std::memory_order_relaxed);
+  while (!state_.compare_exchange_weak(state, state < 0 ? Paused(0) : Ticks(),
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE bool AtomicTimer<Tp_>::IsRunning() const ATLAS_NOEXCEPT {
+  return state_.load(std::memory_order_relaxed) >= 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE typename Tp_::duration AtomicTimer<Tp_>::Elapsed() const
+    ATLAS_NOEXCEPT {
+  const int64_t state = state_.load(std::memory_order_relaxed);
+  return typename Tp_::duration(state < 0 ? Paused(state) : Ticks() - state);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t AtomicTimer<Tp_>::NanoSeconds() const
+    ATLAS_NOEXCEPT {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Elapsed())
+      .count();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t AtomicTimer<Tp_>::MicroSeconds() const
+    ATLAS_NOEXCEPT {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Elapsed())
+      .count();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t AtomicTimer<Tp_>::MilliSeconds() const
+    ATLAS_NOEXCEPT {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Elapsed())
+      .count();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t AtomicTimer<Tp_>::Seconds() const ATLAS_NOEXCEPT {
+  return std::chrono::duration_cast<std::chrono::seconds>(Elapsed()).count();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t AtomicTimer<Tp_>::Ticks() ATLAS_NOEXCEPT {
+  return static_cast<int64_t>(Tp_::now().time_since_epoch().count());
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE int64_t AtomicTimer<Tp_>::Paused(int64_t elapsed)
+    ATLAS_NOEXCEPT {
+  // Its own inverse: decodes the state of a paused timer as well.
+  return -elapsed - 1;
+}
+
 }  // namespace sonia_common
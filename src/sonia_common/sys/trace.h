@@ -0,0 +1,249 @@
+/**
+ * \file	trace.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_SYSTEM_TRACE_H_
+#define SONIA_COMMON_SYSTEM_TRACE_H_
+
+#include <sys/types.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sonia_common/macros.h>
+#include <sonia_common/pattern/runnable.h>
+#include <sonia_common/pattern/singleton.h>
+#include <sonia_common/sys/trace_scope.h>
+
+namespace sonia_common {
+
+/**
+ * Collects the spans of all the threads and writes them to a file in the
+ * Chrome trace event format, which chrome://tracing and Perfetto open.
+ *
+ * Each thread records its spans in a lock-free ring buffer of its own, and
+ * the thread of the Tracer, a Runnable, drains the buffers to the file at
+ * every flush period. A span is written as a single complete event, with
+ * its start and duration, when the scope ends. When a thread records faster
+ * than the buffers are drained, the new spans are dropped and counted.
+ *
+ * The spans are recorded only while the Tracer is open. A closed Tracer costs
+ * a relaxed load per span.
+ */
+class Tracer : public Runnable, public Singleton<Tracer> {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Clock = std::chrono::steady_clock;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  ~Tracer() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C  M E T H O D S
+
+  /**
+   * Start writing the spans to the file at the given path, truncated.
+   *
+   * \param buffer_size The number of spans each thread can hold between two
+   *        flushes, rounded up to a power of two. It applies to the threads
+   *        that record their first span after this call.
+   * \throw std::logic_error if the Tracer is already open.
+   * \throw std::system_error if the file cannot be opened.
+   */
+  void Open(const std::string &path,
+            Clock::duration flush_period = std::chrono::milliseconds(100),
+            size_t buffer_size = 16384);
+
+  /**
+   * Write the remaining spans and close the file.
+   *
+   * \throw std::logic_error if the Tracer is not open.
+   */
+  void Close();
+
+  bool IsOpen() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of spans that did not fit in the buffers since the
+   *         Tracer was opened.
+   */
+  uint64_t DroppedCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * Record a span of the calling thread, the times in ticks of the Clock.
+   * Use the SONIA_TRACE_SCOPE macro rather than calling it directly.
+   */
+  void Record(const char *name, Clock::rep start, Clock::rep end)
+      ATLAS_NOEXCEPT;
+
+  static Clock::rep Now() ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void Run() override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Event {
+    const char *name;
+
+    Clock::rep start;
+
+    Clock::rep end;
+  };
+
+  /**
+   * A ring of events with a single producer, the thread it belongs to, and a
+   * single consumer, the thread of the Tracer.
+   */
+  struct Buffer {
+    explicit Buffer(size_t capacity);
+
+    /**
+     * \return false if the buffer is full.
+     */
+    bool Push(const Event &event) ATLAS_NOEXCEPT;
+
+    std::vector<Event> events;
+
+    const uint64_t mask;
+
+    std::atomic<uint64_t> head;
+
+    std::atomic<uint64_t> tail;
+
+    /**
+     * Set when the thread exits, the buffer is released once drained.
+     */
+    std::atomic<bool> finished;
+
+    pid_t tid;
+
+    std::string thread_name;
+
+    /**
+     * Whether the name of the thread was written, for the consumer.
+     */
+    bool named;
+  };
+
+  /**
+   * Releases the buffer of a thread when it exits.
+   */
+  struct BufferReleaser {
+    ~BufferReleaser();
+
+    std::shared_ptr<Buffer> buffer;
+  };
+
+  //============================================================================
+  // P R I V A T E   C / D T O R S
+
+  Tracer();
+
+  friend class Singleton<Tracer>;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * \return The buffer of the calling thread, created on its first span.
+   */
+  Buffer *LocalBuffer() ATLAS_NOEXCEPT;
+
+  /**
+   * Write the events of all the buffers to the file.
+   */
+  void Flush();
+
+  void WriteEvent(const Buffer &buffer, const char *name, char phase,
+                  Clock::rep start, Clock::rep duration);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::atomic<bool> open_;
+
+  std::atomic<uint64_t> dropped_;
+
+  std::atomic<size_t> buffer_size_;
+
+  Clock::duration flush_period_;
+
+  Clock::rep origin_;
+
+  pid_t pid_;
+
+  FILE *file_;
+
+  bool first_event_;
+
+  std::mutex buffers_mutex_;
+
+  std::vector<std::shared_ptr<Buffer>> buffers_;
+};
+
+/**
+ * Records the lifetime of the scope as a span of the Tracer, if it is open.
+ */
+class TraceScope {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit TraceScope(const char *name) ATLAS_NOEXCEPT;
+
+  ~TraceScope() ATLAS_NOEXCEPT;
+
+  TraceScope(const TraceScope &) = delete;
+
+  TraceScope &operator=(const TraceScope &) = delete;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  const char *name_;
+
+  Tracer::Clock::rep start_;
+};
+
+}  // namespace sonia_common
+
+#include <sonia_common/sys/trace_inl.h>
+
+#endif  // SONIA_COMMON_SYSTEM_TRACE_H_
@@ -0,0 +1,329 @@
+/**
+ * \file	trace_inl.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_SYSTEM_TRACE_H_
+#error This file may only be included from trace.h
+#endif
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+namespace sonia_common {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Tracer::Tracer()
+    : Runnable(),
+      Singleton<Tracer>(),
+      open_(false),
+      dropped_(0),
+      buffer_size_(16384),
+      flush_period_(std::chrono::milliseconds(100)),
+      origin_(0),
+      pid_(getpid()),
+      file_(nullptr),
+      first_event_(true),
+      buffers_mutex_(),
+      buffers_() {
+  ThreadOptions options;
+  options.name = "tracer";
+  SetThreadOptions(options);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Tracer::~Tracer() ATLAS_NOEXCEPT {
+  if (IsOpen()) {
+    try {
+      Close();
+    } catch (...) {
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Tracer::Buffer::Buffer(size_t capacity)
+    : events(capacity),
+      mask(capacity - 1),
+      head(0),
+      tail(0),
+      finished(false),
+      tid(static_cast<pid_t>(syscall(SYS_gettid))),
+      thread_name(),
+      named(false) {
+  char name[16] = {};
+  if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0) {
+    thread_name = name;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Tracer::BufferReleaser::~BufferReleaser() {
+  if (buffer) {
+    buffer->finished.store(true, std::memory_order_release);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE TraceScope::TraceScope(const char *name) ATLAS_NOEXCEPT
+    : name_(name),
+      start_(Tracer::Instance().IsOpen() ? Tracer::Now() : 0) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE TraceScope::~TraceScope() ATLAS_NOEXCEPT {
+  if (start_ != 0) {
+    Tracer::Instance().Record(name_, start_, Tracer::Now());
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Tracer::Open(const std::string &path,
+                               Clock::duration flush_period,
+                               size_t buffer_size) {
+  if (IsOpen()) {
+    throw std::logic_error("The tracer is already open.");
+  }
+
+  file_ = fopen(path.c_str(), "w");
+  if (file_ == nullptr) {
+    throw std::system_error(errno, std::system_category(), path);
+  }
+  fputs("{\"traceEvents\":[\n", file_);
+  first_event_ = true;
+
+  size_t capacity = 1;
+  while (capacity < buffer_size) {
+    capacity <<= 1;
+  }
+  buffer_size_ = capacity;
+  flush_period_ = flush_period;
+  origin_ = Now();
+  dropped_ = 0;
+  {
+    // Drop what was recorded by the spans that ended after the last Close().
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    for (auto &buffer : buffers_) {
+      buffer->tail.store(buffer->head.load(std::memory_order_acquire),
+                         std::memory_order_release);
+      buffer->named = false;
+    }
+  }
+
+  Start();
+  open_.store(true, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Tracer::Close() {
+  if (!IsOpen()) {
+    throw std::logic_error("The tracer is not open.");
+  }
+  open_.store(false, std::memory_order_release);
+  // The thread of the tracer flushes the remaining events before it exits.
+  Stop();
+
+  fputs("\n]}\n", file_);
+  fclose(file_);
+  file_ = nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE bool Tracer::IsOpen() const ATLAS_NOEXCEPT {
+  return open_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t Tracer::DroppedCount() const ATLAS_NOEXCEPT {
+  return dropped_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void Tracer::Record(const char *name, Clock::rep start,
+                                        Clock::rep end) ATLAS_NOEXCEPT {
+  Buffer *buffer = LocalBuffer();
+  Event event = {name, start, end};
+  if (buffer == nullptr || !buffer->Push(event)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Tracer::Clock::rep Tracer::Now() ATLAS_NOEXCEPT {
+  return Clock::now().time_since_epoch().count();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE bool Tracer::Buffer::Push(const Event &event)
+    ATLAS_NOEXCEPT {
+  const uint64_t position = head.load(std::memory_order_relaxed);
+  if (position - tail.load(std::memory_order_acquire) > mask) {
+    return false;
+  }
+  events[position & mask] = event;
+  head.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Tracer::Run() {
+  while (WaitFor(flush_period_)) {
+    Flush();
+  }
+  Flush();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Tracer::Buffer *Tracer::LocalBuffer() ATLAS_NOEXCEPT {
+  static thread_local Buffer *local_buffer = nullptr;
+  if (local_buffer != nullptr) {
+    return local_buffer;
+  }
+
+  try {
+    std::shared_ptr<Buffer> buffer = std::make_shared<Buffer>(buffer_size_);
+    static thread_local BufferReleaser releaser;
+    releaser.buffer = buffer;
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    buffers_.push_back(buffer);
+    local_buffer = buffer.get();
+  } catch (...) {
+    // Out of memory: the spans of this thread are counted as dropped.
+  }
+  return local_buffer;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Tracer::Flush() {
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    buffers = buffers_;
+  }
+
+  for (auto &buffer : buffers) {
+    // Read the flag first: the events pushed before the thread exited are
+    // drained below.
+    const bool finished = buffer->finished.load(std::memory_order_acquire);
+    const uint64_t head = buffer->head.load(std::memory_order_acquire);
+    uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+    if (tail != head && !buffer->named) {
+      WriteEvent(*buffer, "thread_name", 'M', 0, 0);
+      buffer->named = true;
+    }
+    for (; tail != head; ++tail) {
+      const Event &event = buffer->events[tail & buffer->mask];
+      if (event.start < origin_) {
+        // Started before the Tracer was opened.
+        continue;
+      }
+      WriteEvent(*buffer, event.name, 'X', event.start - origin_,
+                 event.end - event.start);
+    }
+    buffer->tail.store(tail, std::memory_order_release);
+
+    if (finished) {
+      std::lock_guard<std::mutex> lock(buffers_mutex_);
+      for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
+        if (*it == buffer) {
+          buffers_.erase(it);
+          break;
+        }
+      }
+    }
+  }
+  fflush(file_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Tracer::WriteEvent(const Buffer &buffer, const char *name,
+                                     char phase, Clock::rep start,
+                                     Clock::rep duration) {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+
+  if (!first_event_) {
+    fputs(",\n", file_);
+  }
+  first_event_ = false;
+
+  // The names are string literals of the code, only the quotes and the
+  // backslashes need escaping.
+  std::string escaped;
+  const char *label = phase == 'M' ? buffer.thread_name.c_str() : name;
+  for (const char *c = label; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(*c);
+  }
+
+  if (phase == 'M') {
+    fprintf(file_,
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+            "\"args\":{\"name\":\"%s\"}}",
+            static_cast<int>(pid_), static_cast<int>(buffer.tid),
+            escaped.c_str());
+    return;
+  }
+
+  // The trace event format counts in microseconds.
+  const long long start_ns =
+      duration_cast<nanoseconds>(Clock::duration(start)).count();
+  const long long duration_ns =
+      duration_cast<nanoseconds>(Clock::duration(duration)).count();
+  fprintf(file_,
+          "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lld.%03lld,"
+          "\"dur\":%lld.%03lld,\"pid\":%d,\"tid\":%d}",
+          escaped.c_str(), start_ns / 1000, start_ns % 1000,
+          duration_ns / 1000, duration_ns % 1000, static_cast<int>(pid_),
+          static_cast<int>(buffer.tid));
+}
+
+}  // namespace sonia_common
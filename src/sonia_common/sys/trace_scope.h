@@ -0,0 +1,51 @@
+/**
+ * \file	trace_scope.h
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SONIA_COMMON_SYSTEM_TRACE_SCOPE_H_
+#define SONIA_COMMON_SYSTEM_TRACE_SCOPE_H_
+
+/**
+ * Trace the enclosing scope under the given name, which must be a string
+ * literal, e.g. SONIA_TRACE_SCOPE("vision.filters").
+ *
+ * The spans are only compiled when SONIA_TRACE is defined, before including
+ * this header or with add_definitions(-DSONIA_TRACE). Otherwise the macro
+ * expands to nothing and the Tracer is not included at all, so the headers
+ * that trace their hot paths stay light. SONIA_TRACE must be set the same
+ * way in every translation unit of a program: it changes the body of inline
+ * functions such as Subject::Notify().
+ */
+#if defined(SONIA_TRACE)
+#include <sonia_common/sys/trace.h>
+#define SONIA_TRACE_CONCAT_(a, b) a##b
+#define SONIA_TRACE_CONCAT(a, b) SONIA_TRACE_CONCAT_(a, b)
+#define SONIA_TRACE_SCOPE(name)                                  \
+  ::sonia_common::TraceScope SONIA_TRACE_CONCAT(sonia_trace_scope_, \
+                                                __COUNTER__)(name)
+#else
+#define SONIA_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif  // SONIA_COMMON_SYSTEM_TRACE_SCOPE_H_
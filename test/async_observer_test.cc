@@ -0,0 +1,212 @@
+/**
+ * \file	async_observer_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/async_observer.h>
+#include <sonia_common/pattern/subject.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sonia_common;
+
+namespace {
+
+class Source : public Subject<const std::string &, int> {
+ public:
+  void Send(const std::string &str, int i) { Notify(str, i); }
+};
+
+using StringObserver = AsyncObserver<const std::string &, int>;
+
+}  // namespace
+
+TEST(AsyncObserver, handlesNotificationsInOrder) {
+  ThreadPool pool(4);
+  Source source;
+  std::vector<int> received;
+  StringObserver observer(pool, [&received](const std::string &str, int i) {
+    ASSERT_EQ(std::to_string(i), str);
+    received.push_back(i);
+  });
+  observer.Observe(source);
+
+  for (int i = 0; i < 1000; ++i) {
+    source.Send(std::to_string(i), i);
+  }
+  observer.Flush();
+
+  ASSERT_EQ(1000u, received.size());
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(i, received[i]);
+  }
+  ASSERT_EQ(1000u, observer.HandledCount());
+  ASSERT_EQ(0u, observer.DroppedCount());
+}
+
+TEST(AsyncObserver, slowObserverDoesNotBlockProducer) {
+  ThreadPool pool(2);
+  Source source;
+  std::atomic<bool> release(false);
+  std::atomic<int> fast_count(0);
+
+  StringObserver::Options options;
+  options.max_pending = 4;
+  options.overflow = StringObserver::OverflowPolicy::kDropOldest;
+  StringObserver slow(pool, [&release](const std::string &, int) {
+    while (!release) {
+      std::this_thread::yield();
+    }
+  }, options);
+  StringObserver fast(pool, [&fast_count](const std::string &, int) {
+    ++fast_count;
+  });
+  slow.Observe(source);
+  fast.Observe(source);
+
+  for (int i = 0; i < 100; ++i) {
+    source.Send("", i);
+  }
+  fast.Flush();
+  EXPECT_EQ(100, fast_count);
+  EXPECT_LE(slow.PendingCount(), 4u);
+  EXPECT_GE(slow.DroppedCount(), 95u);
+
+  release = true;
+  slow.Flush();
+  ASSERT_EQ(100u, slow.HandledCount() + slow.DroppedCount());
+}
+
+TEST(AsyncObserver, dropNewestKeepsOldest) {
+  ThreadPool pool(1);
+  Source source;
+  std::atomic<bool> release(false);
+  std::vector<int> received;
+
+  StringObserver::Options options;
+  options.max_pending = 2;
+  options.overflow = StringObserver::OverflowPolicy::kDropNewest;
+  StringObserver observer(pool, [&](const std::string &, int i) {
+    while (!release) {
+      std::this_thread::yield();
+    }
+    received.push_back(i);
+  }, options);
+  observer.Observe(source);
+
+  source.Send("", 0);
+  while (observer.PendingCount() != 0) {
+    std::this_thread::yield();
+  }
+  // The first notification is now being handled, two more can be queued.
+  for (int i = 1; i < 10; ++i) {
+    source.Send("", i);
+  }
+  release = true;
+  observer.Flush();
+
+  ASSERT_EQ(std::vector<int>({0, 1, 2}), received);
+  ASSERT_EQ(7u, observer.DroppedCount());
+}
+
+TEST(AsyncObserver, blockPolicyDoesNotDeadlockOnWorker) {
+  // The notifying task runs on the only worker of the pool, the observer
+  // tasks can only run when the producer helps.
+  ThreadPool pool(1);
+  Source source;
+  std::atomic<int> count(0);
+
+  StringObserver::Options options;
+  options.max_pending = 2;
+  StringObserver observer(pool, [&count](const std::string &, int) {
+    ++count;
+  }, options);
+  observer.Observe(source);
+
+  pool.Enqueue([&source] {
+    for (int i = 0; i < 100; ++i) {
+      source.Send("", i);
+    }
+  }).get();
+  observer.Flush();
+
+  ASSERT_EQ(100, count);
+  ASSERT_EQ(0u, observer.DroppedCount());
+}
+
+TEST(AsyncObserver, ownExecutor) {
+  Source source;
+  std::atomic<int> count(0);
+  std::thread::id handler_thread;
+  {
+    StringObserver observer([&](const std::string &, int) {
+      handler_thread = std::this_thread::get_id();
+      ++count;
+    });
+    observer.Observe(source);
+    for (int i = 0; i < 10; ++i) {
+      source.Send("", i);
+    }
+    // The destructor waits for the queued notifications.
+  }
+  ASSERT_EQ(10, count);
+  ASSERT_NE(std::this_thread::get_id(), handler_thread);
+  ASSERT_EQ(0u, source.ObserverCount());
+}
+
+TEST(AsyncObserverBenchmark, notifyWithSlowObserver) {
+  ThreadPool pool(2);
+  Source source;
+  StringObserver::Options options;
+  options.max_pending = 64;
+  options.overflow = StringObserver::OverflowPolicy::kDropOldest;
+  StringObserver slow(pool, [](const std::string &, int) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }, options);
+  StringObserver fast(pool, [](const std::string &, int) {}, options);
+  slow.Observe(source);
+  fast.Observe(source);
+
+  const int kCount = 100000;
+  const std::string payload(64, 'x');
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kCount; ++i) {
+    source.Send(payload, i);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "[ BENCHMARK] "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                       .count() / kCount
+            << " ns per Notify() with a slow observer, " << slow.DroppedCount()
+            << " dropped" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
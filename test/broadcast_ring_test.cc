@@ -0,0 +1,257 @@
+/**
+ * \file	broadcast_ring_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/broadcast_ring.h>
+#include <sonia_common/pattern/observer.h>
+#include <sonia_common/pattern/subject.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace sonia_common;
+
+namespace {
+
+using Ring = BroadcastRing<uint64_t>;
+
+std::vector<Ring::WaitStrategy> Strategies() {
+  std::vector<Ring::WaitStrategy> strategies = {Ring::WaitStrategy::kYield,
+                                                Ring::WaitStrategy::kBlock};
+  // Spinning consumers would starve the producer without a core each.
+  if (std::thread::hardware_concurrency() >= 4) {
+    strategies.push_back(Ring::WaitStrategy::kBusySpin);
+  }
+  return strategies;
+}
+
+struct Sample {
+  std::chrono::steady_clock::time_point stamp;
+  double values[9];
+};
+
+class SampleSubject : public Subject<const Sample &> {
+ public:
+  void Publish(const Sample &sample) { Notify(sample); }
+};
+
+class LatencyObserver : public Observer<const Sample &> {
+ public:
+  std::chrono::nanoseconds total_latency = std::chrono::nanoseconds(0);
+  double sum = 0;
+
+ protected:
+  void OnSubjectNotify(Subject<const Sample &> &,
+                       const Sample &sample) override {
+    total_latency += std::chrono::steady_clock::now() - sample.stamp;
+    sum += sample.values[0];
+  }
+};
+
+}  // namespace
+
+TEST(BroadcastRing, everyConsumerReadsEveryValueInOrder) {
+  for (auto strategy : Strategies()) {
+    const uint64_t kCount = 100000;
+    Ring ring(64, strategy);
+    std::vector<std::unique_ptr<Ring::Consumer>> consumers;
+    std::vector<std::thread> threads;
+    std::atomic<int> errors(0);
+    for (int i = 0; i < 3; ++i) {
+      consumers.emplace_back(new Ring::Consumer(ring));
+    }
+    for (auto &consumer : consumers) {
+      Ring::Consumer *c = consumer.get();
+      threads.emplace_back([c, &errors] {
+        uint64_t expected = 0;
+        while (c->Wait([&](uint64_t value) {
+          if (value != expected++) {
+            ++errors;
+          }
+        })) {
+        }
+        if (expected != kCount) {
+          ++errors;
+        }
+      });
+    }
+
+    for (uint64_t i = 0; i < kCount; ++i) {
+      ring.Publish(i);
+    }
+    ring.Close();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(0, errors);
+    ASSERT_EQ(kCount, ring.Sequence());
+  }
+}
+
+TEST(BroadcastRing, pollHandlesReadyValuesInBatch) {
+  Ring ring(8);
+  ring.Publish(1);
+  Ring::Consumer consumer(ring);
+  ASSERT_EQ(1u, consumer.Sequence());
+  ASSERT_EQ(0u, consumer.Poll([](uint64_t) {}));
+
+  for (uint64_t i = 2; i <= 6; ++i) {
+    ring.PublishWith([i](uint64_t &slot) { slot = i; });
+  }
+  ASSERT_EQ(5u, consumer.Lag());
+
+  std::vector<uint64_t> values;
+  auto handler = [&values](uint64_t value) { values.push_back(value); };
+  ASSERT_EQ(2u, consumer.Poll(handler, 2));
+  ASSERT_EQ(3u, consumer.Poll(handler));
+  ASSERT_EQ(std::vector<uint64_t>({2, 3, 4, 5, 6}), values);
+  ASSERT_EQ(0u, consumer.Lag());
+}
+
+TEST(BroadcastRing, closeWakesConsumers) {
+  Ring ring(8, Ring::WaitStrategy::kBlock);
+  Ring::Consumer consumer(ring);
+  std::thread thread([&consumer] {
+    while (consumer.Wait([](uint64_t) {})) {
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ring.Close();
+  thread.join();
+  ASSERT_TRUE(ring.IsClosed());
+}
+
+TEST(BroadcastRing, slowestConsumerGatesProducer) {
+  Ring ring(4, Ring::WaitStrategy::kBlock);
+  std::unique_ptr<Ring::Consumer> idle(new Ring::Consumer(ring));
+  Ring::Consumer reader(ring);
+  for (uint64_t i = 0; i < 4; ++i) {
+    ring.Publish(i);
+  }
+
+  std::atomic<bool> published(false);
+  std::thread producer([&] {
+    ring.Publish(4);
+    published = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(published);
+
+  // Reading with one consumer is not enough, the idle one holds the slot.
+  reader.Poll([](uint64_t) {});
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(published);
+
+  idle.reset();
+  producer.join();
+  ASSERT_TRUE(published);
+  ASSERT_EQ(1u, ring.ConsumerCount());
+  ASSERT_EQ(1u, reader.Lag());
+}
+
+TEST(BroadcastRingBenchmark, compareWithSubject) {
+  const int kCount = 200000;
+  const int kConsumers = 3;
+
+  {
+    SampleSubject subject;
+    std::vector<std::unique_ptr<LatencyObserver>> observers;
+    for (int i = 0; i < kConsumers; ++i) {
+      observers.emplace_back(new LatencyObserver());
+      subject.Attach(*observers.back());
+    }
+    Sample sample = {};
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kCount; ++i) {
+      sample.stamp = std::chrono::steady_clock::now();
+      sample.values[0] = i;
+      subject.Publish(sample);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "[ BENCHMARK] Subject        "
+              << kCount * 1000.0 /
+                     std::chrono::duration_cast<std::chrono::microseconds>(
+                         elapsed).count()
+              << " samples/ms, mean latency "
+              << observers[0]->total_latency.count() / kCount << " ns"
+              << std::endl;
+  }
+
+  const char *names[] = {"busy spin", "yield    ", "block    "};
+  for (auto strategy : {BroadcastRing<Sample>::WaitStrategy::kYield,
+                        BroadcastRing<Sample>::WaitStrategy::kBlock,
+                        BroadcastRing<Sample>::WaitStrategy::kBusySpin}) {
+    if (strategy == BroadcastRing<Sample>::WaitStrategy::kBusySpin &&
+        std::thread::hardware_concurrency() <= kConsumers) {
+      continue;
+    }
+    BroadcastRing<Sample> ring(1024, strategy);
+    std::vector<std::unique_ptr<BroadcastRing<Sample>::Consumer>> consumers;
+    std::vector<std::chrono::nanoseconds> latencies(kConsumers);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kConsumers; ++i) {
+      consumers.emplace_back(new BroadcastRing<Sample>::Consumer(ring));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kConsumers; ++i) {
+      BroadcastRing<Sample>::Consumer *consumer = consumers[i].get();
+      std::chrono::nanoseconds *latency = &latencies[i];
+      threads.emplace_back([consumer, latency] {
+        std::chrono::nanoseconds total(0);
+        while (consumer->Wait([&total](const Sample &sample) {
+          total += std::chrono::steady_clock::now() - sample.stamp;
+        })) {
+        }
+        *latency = total;
+      });
+    }
+    for (int i = 0; i < kCount; ++i) {
+      ring.PublishWith([i](Sample &sample) {
+        sample.stamp = std::chrono::steady_clock::now();
+        sample.values[0] = i;
+      });
+    }
+    ring.Close();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "[ BENCHMARK] Ring "
+              << names[static_cast<int>(strategy)] << " "
+              << kCount * 1000.0 /
+                     std::chrono::duration_cast<std::chrono::microseconds>(
+                         elapsed).count()
+              << " samples/ms, mean latency " << latencies[0].count() / kCount
+              << " ns" << std::endl;
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+/**
+ * \file	conflating_observer_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/conflating_observer.h>
+#include <sonia_common/pattern/subject.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace sonia_common;
+
+namespace {
+
+class Imu : public Subject<const std::vector<double> &, int> {
+ public:
+  void Publish(int i) { Notify(std::vector<double>(9, i), i); }
+};
+
+using ImuObserver = ConflatingObserver<const std::vector<double> &, int>;
+
+}  // namespace
+
+TEST(ConflatingObserver, handlesLatestValue) {
+  Imu imu;
+  std::atomic<bool> started(false);
+  std::atomic<bool> release(false);
+  std::vector<int> received;
+  ImuObserver observer([&](const std::vector<double> &values, int i) {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+    ASSERT_EQ(9u, values.size());
+    ASSERT_EQ(i, values[0]);
+    received.push_back(i);
+  });
+  observer.Observe(imu);
+
+  imu.Publish(0);
+  while (!started) {
+    std::this_thread::yield();
+  }
+  // The handler is now blocked on the first value, the next ones conflate.
+  for (int i = 1; i <= 100; ++i) {
+    imu.Publish(i);
+  }
+  release = true;
+  observer.Flush();
+
+  ASSERT_FALSE(received.empty());
+  ASSERT_EQ(100, received.back());
+  ASSERT_EQ(101u, observer.ReceivedCount());
+  ASSERT_EQ(received.size(), observer.HandledCount());
+  ASSERT_EQ(101u, observer.HandledCount() + observer.DroppedCount());
+  ASSERT_GE(observer.CoalescedCount(), 1u);
+  for (size_t i = 1; i < received.size(); ++i) {
+    ASSERT_LT(received[i - 1], received[i]);
+  }
+}
+
+TEST(ConflatingObserver, handlesEveryValueWhenFastEnough) {
+  Imu imu;
+  std::vector<int> received;
+  ImuObserver observer([&](const std::vector<double> &, int i) {
+    received.push_back(i);
+  });
+  observer.Observe(imu);
+
+  for (int i = 1; i <= 10; ++i) {
+    imu.Publish(i);
+    observer.Flush();
+  }
+
+  ASSERT_EQ(10u, received.size());
+  ASSERT_EQ(0u, observer.DroppedCount());
+  ASSERT_EQ(0u, observer.CoalescedCount());
+}
+
+TEST(ConflatingObserver, concurrentProducers) {
+  Imu imu_1;
+  Imu imu_2;
+  std::atomic<int> count(0);
+  ImuObserver observer([&](const std::vector<double> &values, int i) {
+    ASSERT_EQ(i, values[8]);
+    ++count;
+  });
+  observer.Observe(imu_1);
+  observer.Observe(imu_2);
+
+  std::thread producer([&imu_2] {
+    for (int i = 0; i < 10000; ++i) {
+      imu_2.Publish(-i);
+    }
+  });
+  for (int i = 0; i < 10000; ++i) {
+    imu_1.Publish(i);
+  }
+  producer.join();
+  observer.Flush();
+
+  ASSERT_EQ(20000u, observer.ReceivedCount());
+  ASSERT_EQ(20000u, observer.HandledCount() + observer.DroppedCount());
+  ASSERT_EQ(count, observer.HandledCount());
+}
+
+TEST(ConflatingObserver, destructorHandlesLastValue) {
+  Imu imu;
+  std::atomic<int> last(-1);
+  {
+    ImuObserver observer([&](const std::vector<double> &, int i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      last = i;
+    });
+    observer.Observe(imu);
+    for (int i = 0; i < 20; ++i) {
+      imu.Publish(i);
+    }
+  }
+  ASSERT_EQ(19, last);
+  ASSERT_EQ(0u, imu.ObserverCount());
+}
+
+TEST(ConflatingObserverBenchmark, notifyWithSlowObserver) {
+  Imu imu;
+  ImuObserver observer([](const std::vector<double> &, int) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  });
+  observer.Observe(imu);
+
+  const int kCount = 100000;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kCount; ++i) {
+    imu.Publish(i);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  observer.Flush();
+  std::cout << "[ BENCHMARK] "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                       .count() / kCount
+            << " ns per Notify(), " << observer.HandledCount() << " handled, "
+            << observer.DroppedCount() << " dropped, "
+            << observer.CoalescedCount() << " coalesced" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,250 @@
+/**
+ * \file	event_hub_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/event_hub.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace sonia_common;
+
+namespace {
+
+struct Message {
+  int slave_id;
+  int command;
+};
+
+class MessageObserver : public Observer<const Message &> {
+ public:
+  std::vector<Message> messages;
+
+ protected:
+  void OnSubjectNotify(Subject<const Message &> &,
+                       const Message &message) override {
+    messages.push_back(message);
+  }
+};
+
+class FilteringObserver : public Observer<const Message &> {
+ public:
+  explicit FilteringObserver(int slave_id) : slave_id_(slave_id), count_(0) {}
+
+ protected:
+  void OnSubjectNotify(Subject<const Message &> &,
+                       const Message &message) override {
+    if (message.slave_id == slave_id_) {
+      ++count_;
+    }
+  }
+
+ private:
+  int slave_id_;
+  size_t count_;
+};
+
+using MessageHub = EventHub<int, const Message &>;
+
+}  // namespace
+
+TEST(EventHub, publishReachesOnlyTheTopic) {
+  MessageHub hub(16);
+  MessageObserver dvl;
+  MessageObserver power;
+  MessageObserver far;
+  hub.Subscribe(3, dvl);
+  hub.Subscribe(7, power);
+  // Beyond the direct topics, and negative keys, go through the hash map.
+  hub.Subscribe(1000, far);
+  hub.Subscribe(-1, far);
+  ASSERT_THROW(hub.Subscribe(3, dvl), std::invalid_argument);
+
+  hub.Publish(3, Message{3, 1});
+  hub.Publish(7, Message{7, 2});
+  hub.Publish(1000, Message{1000, 3});
+  hub.Publish(-1, Message{-1, 4});
+  hub.Publish(5, Message{5, 5});
+
+  ASSERT_EQ(1u, dvl.messages.size());
+  ASSERT_EQ(3, dvl.messages[0].slave_id);
+  ASSERT_EQ(1u, power.messages.size());
+  ASSERT_EQ(2u, far.messages.size());
+  ASSERT_EQ(4u, hub.TopicCount());
+  ASSERT_EQ(0u, hub.SubscriberCount(5));
+
+  hub.Unsubscribe(3, dvl);
+  hub.Publish(3, Message{3, 1});
+  ASSERT_EQ(1u, dvl.messages.size());
+  ASSERT_THROW(hub.Unsubscribe(3, dvl), std::invalid_argument);
+  ASSERT_THROW(hub.Unsubscribe(5, dvl), std::invalid_argument);
+}
+
+TEST(EventHub, predicateFiltersEvents) {
+  MessageHub hub;
+  MessageObserver battery;
+  MessageObserver all;
+  hub.Subscribe(7, battery,
+                [](const Message &message) { return message.command == 2; });
+  hub.Subscribe(7, all);
+  ASSERT_THROW(hub.Subscribe(7, battery, [](const Message &) { return true; }),
+               std::invalid_argument);
+  ASSERT_EQ(2u, hub.SubscriberCount(7));
+
+  for (int command = 0; command < 4; ++command) {
+    hub.Publish(7, Message{7, command});
+  }
+  ASSERT_EQ(1u, battery.messages.size());
+  ASSERT_EQ(2, battery.messages[0].command);
+  ASSERT_EQ(4u, all.messages.size());
+
+  hub.Unsubscribe(7, battery);
+  hub.Publish(7, Message{7, 2});
+  ASSERT_EQ(1u, battery.messages.size());
+  ASSERT_EQ(1u, hub.SubscriberCount(7));
+}
+
+TEST(EventHub, destroyedFilteredSubscriberIsRemoved) {
+  MessageHub hub;
+  std::atomic<int> predicates(0);
+  auto predicate = [&predicates](const Message &) {
+    ++predicates;
+    return true;
+  };
+
+  // The second subscriber gets the address of the first one.
+  std::aligned_storage<sizeof(MessageObserver),
+                       alignof(MessageObserver)>::type storage;
+  auto *subscriber = new (&storage) MessageObserver();
+  hub.Subscribe(7, *subscriber, predicate);
+  hub.Publish(7, Message{7, 1});
+  ASSERT_EQ(1, predicates);
+  subscriber->~MessageObserver();
+
+  // The next event finds the filter without subscriber and removes it.
+  hub.Publish(7, Message{7, 2});
+  ASSERT_EQ(1, predicates);
+  ASSERT_EQ(0u, hub.SubscriberCount(7));
+
+  subscriber = new (&storage) MessageObserver();
+  hub.Subscribe(7, *subscriber, predicate);
+  subscriber->~MessageObserver();
+  // Even without an event in between.
+  subscriber = new (&storage) MessageObserver();
+  hub.Subscribe(7, *subscriber, predicate);
+  hub.Publish(7, Message{7, 3});
+  ASSERT_EQ(2, predicates);
+  ASSERT_EQ(1u, subscriber->messages.size());
+  ASSERT_EQ(1u, hub.SubscriberCount(7));
+  hub.Unsubscribe(7, *subscriber);
+  subscriber->~MessageObserver();
+}
+
+TEST(EventHub, stringTopics) {
+  EventHub<std::string, const Message &> hub;
+  MessageObserver buoys;
+  hub.Subscribe("buoy", buoys);
+  hub.Publish("buoy", Message{0, 1});
+  hub.Publish("fence", Message{0, 2});
+  ASSERT_EQ(1u, buoys.messages.size());
+}
+
+TEST(EventHub, subscribeWhilePublishing) {
+  MessageHub hub(8);
+  std::atomic<bool> stop(false);
+  std::thread publisher([&hub, &stop] {
+    int i = 0;
+    while (!stop) {
+      hub.Publish(i % 16, Message{i % 16, i});
+      ++i;
+    }
+  });
+
+  for (int i = 0; i < 200; ++i) {
+    MessageObserver observer;
+    hub.Subscribe(i % 16, observer,
+                  [](const Message &message) { return message.command % 2; });
+    hub.Unsubscribe(i % 16, observer);
+  }
+  stop = true;
+  publisher.join();
+  ASSERT_EQ(16u, hub.TopicCount());
+}
+
+TEST(EventHubBenchmark, compareWithFilteringObservers) {
+  const int kTopics = 32;
+  const int kEvents = 1000000;
+
+  std::vector<std::unique_ptr<MessageObserver>> observers;
+  for (int i = 0; i < kTopics; ++i) {
+    observers.emplace_back(new MessageObserver());
+  }
+
+  // What the hub replaces: every observer on one subject, filtering the
+  // slave id in its callback.
+  {
+    Subject<const Message &> subject;
+    std::vector<std::unique_ptr<FilteringObserver>> filtering;
+    for (int i = 0; i < kTopics; ++i) {
+      filtering.emplace_back(new FilteringObserver(i));
+      subject.Attach(*filtering.back());
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kEvents; ++i) {
+      subject.Notify(Message{i % kTopics, i});
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "[ BENCHMARK] one subject, filtering observers: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                         .count() / kEvents
+              << " ns per event" << std::endl;
+  }
+
+  {
+    MessageHub hub;
+    for (int i = 0; i < kTopics; ++i) {
+      hub.Subscribe(i, *observers[i]);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kEvents; ++i) {
+      hub.Publish(i % kTopics, Message{i % kTopics, i});
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "[ BENCHMARK] one topic per slave: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                         .count() / kEvents
+              << " ns per event" << std::endl;
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,199 @@
+/**
+ * \file	future_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/future.h>
+#include <sonia_common/pattern/task_graph.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using sonia_common::Async;
+using sonia_common::Future;
+using sonia_common::MakeReadyFuture;
+using sonia_common::Promise;
+using sonia_common::TaskGraph;
+using sonia_common::ThreadPool;
+using sonia_common::WhenAll;
+using sonia_common::WhenAny;
+
+TEST(Future, thenChainsContinuations) {
+  Promise<int> promise;
+  auto future = promise.GetFuture()
+                    .Then([](int value) { return value * 2; })
+                    .Then([](int value) { return std::to_string(value); });
+  ASSERT_FALSE(future.IsReady());
+
+  promise.SetValue(21);
+  ASSERT_TRUE(future.IsReady());
+  ASSERT_EQ("42", future.Get());
+
+  auto ready = MakeReadyFuture(1).Then([](int value) { return value + 1; });
+  ASSERT_EQ(2, ready.Get());
+
+  bool called = false;
+  MakeReadyFuture().Then([&called] { called = true; }).Get();
+  ASSERT_TRUE(called);
+}
+
+TEST(Future, exceptionsSkipContinuations) {
+  Promise<int> promise;
+  bool called = false;
+  auto future = promise.GetFuture().Then([&called](int value) {
+    called = true;
+    return value;
+  });
+  promise.SetException(std::make_exception_ptr(std::runtime_error("failed")));
+  ASSERT_THROW(future.Get(), std::runtime_error);
+  ASSERT_FALSE(called);
+  ASSERT_THROW(promise.SetValue(1), std::future_error);
+
+  auto thrown = MakeReadyFuture().Then([] { throw std::logic_error("bad"); });
+  ASSERT_THROW(thrown.Get(), std::logic_error);
+
+  Future<void> broken;
+  {
+    Promise<void> abandoned;
+    broken = abandoned.GetFuture();
+  }
+  ASSERT_THROW(broken.Get(), std::future_error);
+  ASSERT_THROW(Future<int>().Get(), std::future_error);
+}
+
+TEST(Future, pipelineOnThreadPool) {
+  ThreadPool pool(4);
+  std::vector<Future<int>> stages;
+  for (int i = 0; i < 16; ++i) {
+    stages.push_back(Async(pool, [](int value) { return value; }, i)
+                         .Then(pool, [](int value) { return value * value; }));
+  }
+
+  auto all = WhenAll(stages).Then(pool, [](
+      const std::vector<Future<int>> &results) {
+    int sum = 0;
+    for (const auto &result : results) {
+      sum += result.Get();
+    }
+    return sum;
+  });
+  ASSERT_EQ(1240, all.Get());
+
+  ASSERT_TRUE(WhenAll(std::vector<Future<void>>()).IsReady());
+}
+
+TEST(Future, whenAnyReturnsFirstReady) {
+  Promise<int> slow;
+  Promise<int> fast;
+  auto any = WhenAny(std::vector<Future<int>>{slow.GetFuture(),
+                                              fast.GetFuture()});
+  ASSERT_FALSE(any.IsReady());
+  fast.SetValue(1);
+  ASSERT_EQ(1u, any.Get());
+  slow.SetValue(0);
+  ASSERT_EQ(1u, any.Get());
+
+  ASSERT_THROW(WhenAny(std::vector<Future<int>>()), std::invalid_argument);
+}
+
+TEST(Future, helpingWaitFromSingleWorker) {
+  // The only worker waits for a task queued behind it: a blocking wait would
+  // never return, a helping one runs the task itself.
+  ThreadPool pool(1);
+  auto outer = Async(pool, [&pool] {
+    auto inner = Async(pool, [] { return 7; });
+    inner.Wait(pool);
+    return inner.Get();
+  });
+  ASSERT_EQ(7, outer.Get());
+}
+
+TEST(TaskGraph, runsInDependencyOrder) {
+  ThreadPool pool(4);
+  TaskGraph graph;
+  std::mutex mutex;
+  std::vector<std::string> order;
+  auto record = [&mutex, &order](const std::string &name) {
+    return [&mutex, &order, name] {
+      std::lock_guard<std::mutex> guard(mutex);
+      order.push_back(name);
+    };
+  };
+
+  // capture -> (detect, filter) -> fuse
+  auto capture = graph.AddNode(record("capture"));
+  auto detect = graph.AddNode(record("detect"), {capture});
+  auto filter = graph.AddNode(record("filter"), {capture});
+  auto fuse = graph.AddNode(record("fuse"));
+  graph.AddDependency(detect, fuse);
+  graph.AddDependency(filter, fuse);
+  ASSERT_EQ(4u, graph.Size());
+  ASSERT_THROW(graph.AddDependency(fuse, capture), std::logic_error);
+  ASSERT_THROW(graph.AddDependency(fuse, fuse), std::logic_error);
+  ASSERT_THROW(graph.AddDependency(fuse, 10), std::out_of_range);
+
+  for (int frame = 0; frame < 10; ++frame) {
+    order.clear();
+    graph.Run(pool).Get();
+    ASSERT_EQ(4u, order.size());
+    ASSERT_EQ("capture", order.front());
+    ASSERT_EQ("fuse", order.back());
+  }
+}
+
+TEST(TaskGraph, overlappingRunsAndExceptions) {
+  ThreadPool pool(4);
+  TaskGraph graph;
+  std::atomic<int> count(0);
+  auto root = graph.AddNode([&count] { ++count; });
+  std::vector<TaskGraph::NodeId> leaves;
+  for (int i = 0; i < 8; ++i) {
+    leaves.push_back(graph.AddNode([&count] { ++count; }, {root}));
+  }
+  graph.AddNode([&count] { ++count; }, leaves);
+
+  std::vector<Future<void>> runs;
+  for (int i = 0; i < 20; ++i) {
+    runs.push_back(graph.Run(pool));
+  }
+  WhenAll(runs).Get();
+  ASSERT_EQ(20 * 10, count.load());
+
+  // A node added after the runs started is only part of the next ones.
+  auto failing = graph.AddNode([] { throw std::runtime_error("failed"); });
+  bool skipped = true;
+  graph.AddNode([&skipped] { skipped = false; }, {failing});
+  ASSERT_THROW(graph.Run(pool).Get(), std::runtime_error);
+  ASSERT_TRUE(skipped);
+
+  ASSERT_TRUE(TaskGraph().Run(pool).IsReady());
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+/**
+ * \file	latency_histogram_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	17/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/sys/latency_histogram.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace sonia_common;
+
+using Clock = LatencyHistogram::Clock;
+
+TEST(LatencyHistogram, bucketsAreContiguous) {
+  for (size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+    const uint64_t lower = LatencyHistogram::LowerBound(i);
+    const uint64_t upper = LatencyHistogram::UpperBound(i);
+    ASSERT_LE(lower, upper);
+    ASSERT_EQ(i, LatencyHistogram::BucketOf(lower));
+    ASSERT_EQ(i, LatencyHistogram::BucketOf(upper));
+    if (i + 1 < LatencyHistogram::kBuckets) {
+      ASSERT_EQ(upper + 1, LatencyHistogram::LowerBound(i + 1));
+    }
+  }
+  ASSERT_EQ(0u, LatencyHistogram::LowerBound(0));
+  ASSERT_EQ(UINT64_MAX,
+            LatencyHistogram::UpperBound(LatencyHistogram::kBuckets - 1));
+}
+
+TEST(LatencyHistogram, relativeErrorIsBounded) {
+  for (uint64_t ticks = 1; ticks < (uint64_t(1) << 62); ticks = ticks * 3 + 1) {
+    const size_t bucket = LatencyHistogram::BucketOf(ticks);
+    const uint64_t width = LatencyHistogram::UpperBound(bucket) -
+                           LatencyHistogram::LowerBound(bucket);
+    ASSERT_LT(static_cast<double>(width) / ticks,
+              1.0 / LatencyHistogram::kSubBuckets);
+  }
+}
+
+TEST(LatencyHistogram, computesThePercentiles) {
+  LatencyHistogram histogram;
+  ASSERT_EQ(Clock::duration::zero(), histogram.Percentile(0.99));
+
+  for (int i = 1; i <= 10000; ++i) {
+    histogram.Record(std::chrono::microseconds(i));
+  }
+  const auto snapshot = histogram.GetSnapshot();
+  ASSERT_EQ(10000u, snapshot.count);
+  ASSERT_EQ(std::chrono::microseconds(1), snapshot.min);
+  ASSERT_EQ(std::chrono::microseconds(10000), snapshot.max);
+  ASSERT_EQ(std::chrono::nanoseconds(5000500), snapshot.Mean());
+
+  const double expected[][2] = {
+      {0.5, 5000}, {0.99, 9900}, {0.999, 9990}, {1.0, 10000}};
+  for (const auto &percentile : expected) {
+    const double value =
+        std::chrono::duration<double, std::micro>(
+            snapshot.Percentile(percentile[0]))
+            .count();
+    ASSERT_GE(value, percentile[1]);
+    ASSERT_LE(value, percentile[1] * (1.0 + 1.0 / 32));
+  }
+  ASSERT_EQ(snapshot.max, snapshot.Percentile(1.0));
+
+  histogram.Reset();
+  ASSERT_EQ(0u, histogram.Count());
+  ASSERT_EQ(Clock::duration::zero(), histogram.GetSnapshot().min);
+}
+
+TEST(LatencyHistogram, mergesTheThreads) {
+  const int kThreads = 4;
+  const int kSamples = 100000;
+  LatencyHistogram shared;
+  std::vector<std::unique_ptr<LatencyHistogram>> locals;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    locals.emplace_back(new LatencyHistogram());
+    LatencyHistogram &local = *locals.back();
+    threads.emplace_back([&shared, &local, t] {
+      for (int i = 0; i < kSamples; ++i) {
+        const Clock::duration sample((t + 1) * 1000 + i % 100);
+        shared.Record(sample);
+        local.Record(sample);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  LatencyHistogram merged;
+  LatencyHistogram::Snapshot snapshots;
+  for (const auto &local : locals) {
+    merged.Merge(*local);
+    snapshots.Merge(local->GetSnapshot());
+  }
+  const auto expected = shared.GetSnapshot();
+  for (const auto &snapshot : {merged.GetSnapshot(), snapshots}) {
+    ASSERT_EQ(uint64_t(kThreads * kSamples), snapshot.count);
+    ASSERT_EQ(expected.total, snapshot.total);
+    ASSERT_EQ(Clock::duration(1000), snapshot.min);
+    ASSERT_EQ(Clock::duration(kThreads * 1000 + 99), snapshot.max);
+    ASSERT_EQ(expected.buckets, snapshot.buckets);
+  }
+}
+
+TEST(LatencyHistogram, recordsTheScope) {
+  LatencyHistogram histogram;
+  {
+    ScopedLatency latency(histogram);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ASSERT_EQ(1u, histogram.Count());
+  ASSERT_GE(histogram.Max(), std::chrono::milliseconds(5));
+}
+
+TEST(LatencyHistogramBenchmark, record) {
+  const int kSamples = 10000000;
+  LatencyHistogram histogram;
+  const auto start = Clock::now();
+  for (int i = 0; i < kSamples; ++i) {
+    histogram.Record(Clock::duration(i));
+  }
+  const double record =
+      std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+      kSamples;
+
+  const auto snapshot_start = Clock::now();
+  const auto snapshot = histogram.GetSnapshot();
+  const double percentile =
+      std::chrono::duration<double, std::micro>(Clock::now() - snapshot_start)
+          .count();
+
+  std::cout << "[ BENCHMARK] LatencyHistogram: " << record
+            << " ns per Record(), " << percentile << " us per GetSnapshot(), "
+            << sizeof(LatencyHistogram) << " bytes, p99.9 "
+            << snapshot.Percentile(0.999).count() << " ticks" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -24,8 +24,15 @@
  */
 
 #include "gtest/gtest.h"
+#include <time.h>
 #include <sonia_common/pattern/observer.h>
 #include <sonia_common/pattern/subject.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 
 class ConcreateObserver : public sonia_common::Observer<const std::string &, int> {
  public:
@@ -107,6 +114,384 @@ TEST(Observer, notify) {
   ASSERT_TRUE(observer.i_ == 42);
 }
 
+class SelfDetachingObserver
+    : public sonia_common::Observer<const std::string &, int> {
+ public:
+  int calls_ = {0};
+
+ protected:
+  auto OnSubjectNotify(sonia_common::Subject<const std::string &, int> &subject,
+                       const std::string &str,
+                       int nb) ATLAS_NOEXCEPT -> void override {
+    ++calls_;
+    subject.Detach(*this);
+  }
+};
+
+class CountingObserver
+    : public sonia_common::Observer<const std::string &, int> {
+ public:
+  std::atomic<int> calls_ = {0};
+  std::atomic<bool> block_ = {false};
+  std::atomic<bool> blocked_ = {false};
+
+ protected:
+  auto OnSubjectNotify(sonia_common::Subject<const std::string &, int> &subject,
+                       const std::string &str,
+                       int nb) ATLAS_NOEXCEPT -> void override {
+    // Only the notifications named "slow" are held.
+    while (block_ && str == "slow") {
+      blocked_ = true;
+      std::this_thread::yield();
+    }
+    ++calls_;
+  }
+};
+
+TEST(Observer, detachFromCallback) {
+  ConcreteSubject subject = {};
+  SelfDetachingObserver observer = {};
+  ConcreateObserver observer_2 = {};
+
+  observer.Observe(subject);
+  observer_2.Observe(subject);
+  subject.DoSomething("first", 1);
+  subject.DoSomething("second", 2);
+  ASSERT_EQ(observer.calls_, 1);
+  ASSERT_FALSE(observer.IsAttached(subject));
+  ASSERT_EQ(observer_2.i_, 2);
+  ASSERT_EQ(subject.ObserverCount(), 1);
+}
+
+TEST(Observer, slowObserverDoesNotBlockAttach) {
+  ConcreteSubject subject = {};
+  CountingObserver slow = {};
+  slow.block_ = true;
+  slow.Observe(subject);
+
+  std::thread notifier([&subject] { subject.DoSomething("slow", 1); });
+  while (!slow.blocked_) {
+    std::this_thread::yield();
+  }
+
+  // The notifier is stuck in the callback, the list can still change and
+  // other notifications still go through.
+  ConcreateObserver observer = {};
+  observer.Observe(subject);
+  subject.DoSomething("fast", 2);
+  ASSERT_EQ(observer.i_, 2);
+  subject.Detach(observer);
+  ASSERT_EQ(subject.ObserverCount(), 1);
+
+  slow.block_ = false;
+  notifier.join();
+  ASSERT_EQ(slow.calls_, 2);
+}
+
+TEST(Observer, detachWaitsForPendingCalls) {
+  ConcreteSubject subject = {};
+  CountingObserver observer = {};
+  observer.block_ = true;
+  observer.Observe(subject);
+
+  std::thread notifier([&subject] { subject.DoSomething("slow", 1); });
+  while (!observer.blocked_) {
+    std::this_thread::yield();
+  }
+  std::thread releaser([&observer] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    observer.block_ = false;
+  });
+
+  // Once detached, the observer can be destroyed safely.
+  subject.Detach(observer);
+  ASSERT_EQ(observer.calls_, 1);
+  notifier.join();
+  releaser.join();
+}
+
+TEST(Observer, detachBlocksWithoutSpinning) {
+  ConcreteSubject subject = {};
+  CountingObserver observer = {};
+  observer.block_ = true;
+  observer.Observe(subject);
+
+  std::thread notifier([&subject] { subject.DoSomething("slow", 1); });
+  while (!observer.blocked_) {
+    std::this_thread::yield();
+  }
+  std::thread releaser([&observer] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    observer.block_ = false;
+  });
+
+  // Spinning would burn the 100 ms on the CPU.
+  timespec start;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+  subject.Detach(observer);
+  timespec end;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+  const double cpu_ms = (end.tv_sec - start.tv_sec) * 1e3 +
+                        (end.tv_nsec - start.tv_nsec) / 1e6;
+  ASSERT_LT(cpu_ms, 50.0);
+  notifier.join();
+  releaser.join();
+}
+
+struct CopyCounter {
+  static int copies;
+  CopyCounter() = default;
+  CopyCounter(const CopyCounter &) { ++copies; }
+  CopyCounter &operator=(const CopyCounter &) {
+    ++copies;
+    return *this;
+  }
+};
+
+int CopyCounter::copies = 0;
+
+template <typename... Args_>
+class NullObserver : public sonia_common::Observer<Args_...> {
+ protected:
+  void OnSubjectNotify(sonia_common::Subject<Args_...> &, Args_...) override {}
+};
+
+TEST(Observer, notifyDoesNotCopyArguments) {
+  const int kObservers = 3;
+
+  sonia_common::Subject<const CopyCounter &> by_reference;
+  sonia_common::SharedSubject<CopyCounter> shared;
+  sonia_common::Subject<CopyCounter> by_value;
+  std::vector<NullObserver<const CopyCounter &>> reference_observers(
+      kObservers);
+  std::vector<NullObserver<const std::shared_ptr<const CopyCounter> &>>
+      shared_observers(kObservers);
+  std::vector<NullObserver<CopyCounter>> value_observers(kObservers);
+  for (int i = 0; i < kObservers; ++i) {
+    reference_observers[i].Observe(by_reference);
+    shared_observers[i].Observe(shared);
+    value_observers[i].Observe(by_value);
+  }
+
+  CopyCounter::copies = 0;
+  by_reference.Notify(CopyCounter());
+  ASSERT_EQ(0, CopyCounter::copies);
+
+  auto payload = std::make_shared<const CopyCounter>();
+  shared.Notify(payload);
+  ASSERT_EQ(0, CopyCounter::copies);
+  ASSERT_EQ(1, payload.use_count());
+
+  // A value argument is still copied for each observer, but not on the way
+  // in Notify().
+  CopyCounter value;
+  by_value.Notify(value);
+  ASSERT_EQ(kObservers, CopyCounter::copies);
+}
+
+/**
+ * Notify cost with a large vector payload for the ways of declaring it.
+ */
+TEST(ObserverBenchmark, notifyLargePayload) {
+  using Payload = std::vector<double>;
+  const int kObservers = 4;
+  const int kNotifications = 200;
+  const auto payload = std::make_shared<const Payload>(1 << 20, 1.);
+
+  auto report = [](const char *name,
+                   std::chrono::steady_clock::duration elapsed) {
+    std::cout << "[ BENCHMARK] " << name << ": "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     elapsed).count() / kNotifications
+              << " ns per Notify()" << std::endl;
+  };
+
+  {
+    sonia_common::Subject<Payload> subject;
+    std::vector<NullObserver<Payload>> observers(kObservers);
+    for (auto &observer : observers) {
+      observer.Observe(subject);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNotifications; ++i) {
+      subject.Notify(*payload);
+    }
+    report("Subject<vector>              ",
+           std::chrono::steady_clock::now() - start);
+  }
+  {
+    sonia_common::Subject<const Payload &> subject;
+    std::vector<NullObserver<const Payload &>> observers(kObservers);
+    for (auto &observer : observers) {
+      observer.Observe(subject);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNotifications; ++i) {
+      subject.Notify(*payload);
+    }
+    report("Subject<const vector &>      ",
+           std::chrono::steady_clock::now() - start);
+  }
+  {
+    sonia_common::SharedSubject<Payload> subject;
+    std::vector<NullObserver<const std::shared_ptr<const Payload> &>>
+        observers(kObservers);
+    for (auto &observer : observers) {
+      observer.Observe(subject);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNotifications; ++i) {
+      subject.Notify(payload);
+    }
+    report("SharedSubject<vector>        ",
+           std::chrono::steady_clock::now() - start);
+  }
+}
+
+class SleepingObserver
+    : public sonia_common::Observer<const std::string &, int> {
+ protected:
+  void OnSubjectNotify(sonia_common::Subject<const std::string &, int> &,
+                       const std::string &, int nb) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(nb));
+  }
+};
+
+TEST(Observer, tracingRecordsEachObserver) {
+  ConcreteSubject subject = {};
+  SleepingObserver slow = {};
+  CountingObserver fast = {};
+  slow.SetName("slow");
+  slow.Observe(subject);
+  fast.Observe(subject);
+
+  std::vector<std::string> lines;
+  ConcreteSubject::TracingOptions options;
+  options.name = "camera";
+  options.budget = std::chrono::milliseconds(1);
+  options.log_period = std::chrono::milliseconds(1);
+  options.log = [&lines](const std::string &line) { lines.push_back(line); };
+
+  subject.DoSomething("untraced", 0);
+  ASSERT_FALSE(subject.IsTracing());
+  subject.EnableTracing(options);
+  for (int i = 0; i < 5; ++i) {
+    subject.DoSomething("traced", 2);
+  }
+  subject.DisableTracing();
+  subject.DoSomething("untraced", 0);
+
+  auto traces = subject.GetTraces();
+  ASSERT_EQ(2u, traces.size());
+  ASSERT_EQ("slow", traces[0].name);
+  ASSERT_NE(std::string::npos, traces[1].name.find("CountingObserver"));
+
+  ASSERT_EQ(5u, traces[0].count);
+  ASSERT_EQ(5u, traces[0].over_budget);
+  ASSERT_GE(traces[0].Mean(), std::chrono::milliseconds(2));
+  ASSERT_GE(traces[0].Percentile(0.5), std::chrono::milliseconds(1));
+  ASSERT_EQ(5u, traces[1].count);
+  ASSERT_EQ(0u, traces[1].over_budget);
+
+  // The log lines come by pair, one per observer.
+  ASSERT_FALSE(lines.empty());
+  ASSERT_EQ(0u, lines.size() % 2);
+  ASSERT_EQ(0u, lines[0].find("[camera] slow: "));
+  ASSERT_NE(std::string::npos, lines[0].find("OVER BUDGET"));
+  ASSERT_EQ(std::string::npos, lines[1].find("OVER BUDGET"));
+
+  subject.ResetTraces();
+  ASSERT_EQ(0u, subject.GetTraces()[0].count);
+}
+
+TEST(Observer, tracingCoversTheLaterObservers) {
+  ConcreteSubject subject = {};
+  CountingObserver early = {};
+  early.Observe(subject);
+  subject.DoSomething("untraced", 0);
+  ASSERT_EQ(0u, subject.GetTraces()[0].count);
+
+  subject.EnableTracing();
+  CountingObserver late = {};
+  late.Observe(subject);
+  subject.DoSomething("traced", 0);
+
+  auto traces = subject.GetTraces();
+  ASSERT_EQ(2u, traces.size());
+  ASSERT_EQ(1u, traces[0].count);
+  ASSERT_EQ(1u, traces[1].count);
+}
+
+class AttachedObserver
+    : public sonia_common::Observer<const std::string &, int> {
+ public:
+  explicit AttachedObserver(
+      sonia_common::Subject<const std::string &, int> &subject)
+      : sonia_common::Observer<const std::string &, int>(subject) {}
+
+ protected:
+  void OnSubjectNotify(sonia_common::Subject<const std::string &, int> &,
+                       const std::string &, int) override {}
+};
+
+TEST(Observer, tracingNamesTheObserversWhenAsked) {
+  ConcreteSubject subject = {};
+  AttachedObserver observer(subject);
+
+  // Attached from the base constructor, but named by its own type.
+  auto traces = subject.GetTraces();
+  ASSERT_EQ(1u, traces.size());
+  ASSERT_NE(std::string::npos, traces[0].name.find("AttachedObserver"));
+
+  observer.SetName("renamed");
+  ASSERT_EQ("renamed", subject.GetTraces()[0].name);
+}
+
+/**
+ * Notify throughput for a growing number of observers, while another thread
+ * keeps attaching and detaching an observer.
+ */
+TEST(ObserverBenchmark, notifyWithChurn) {
+  const int notifications = 20000;
+  for (size_t count = 1; count <= 64; count *= 2) {
+    ConcreteSubject subject = {};
+    std::vector<std::unique_ptr<CountingObserver>> observers;
+    for (size_t i = 0; i < count; ++i) {
+      observers.emplace_back(new CountingObserver());
+      observers.back()->Observe(subject);
+    }
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> churns(0);
+    std::thread churner([&subject, &stop, &churns] {
+      while (!stop) {
+        CountingObserver observer;
+        observer.Observe(subject);
+        subject.Detach(observer);
+        ++churns;
+      }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < notifications; ++i) {
+      subject.DoSomething("benchmark", i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    stop = true;
+    churner.join();
+
+    for (const auto &observer : observers) {
+      ASSERT_EQ(observer->calls_, notifications);
+    }
+    std::cout << "[ BENCHMARK] " << count << " observers: "
+              << notifications * 1000. / std::max<int64_t>(elapsed, 1)
+              << " notifications/ms, " << churns << " attach/detach"
+              << std::endl;
+  }
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,161 @@
+/**
+ * \file	periodic_runnable_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/periodic_runnable.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+using namespace sonia_common;
+
+namespace {
+
+class SleepingStep : public PeriodicRunnable {
+ public:
+  SleepingStep(std::chrono::nanoseconds period, OverrunPolicy policy,
+               std::chrono::nanoseconds step_time, uint64_t slow_steps)
+      : PeriodicRunnable(period, policy),
+        step_time_(step_time),
+        slow_steps_(slow_steps),
+        count_(0) {}
+
+  uint64_t Count() const { return count_; }
+
+ protected:
+  void Step() override {
+    if (count_++ < slow_steps_) {
+      std::this_thread::sleep_for(step_time_);
+    }
+  }
+
+ private:
+  const std::chrono::nanoseconds step_time_;
+  const uint64_t slow_steps_;
+  std::atomic<uint64_t> count_;
+};
+
+}  // namespace
+
+TEST(PeriodicRunnable, rejectsNonPositivePeriod) {
+  ASSERT_THROW(SleepingStep(std::chrono::nanoseconds(0),
+                            PeriodicRunnable::OverrunPolicy::kSkip,
+                            std::chrono::nanoseconds(0), 0),
+               std::invalid_argument);
+}
+
+TEST(PeriodicRunnable, stepsAtTheGivenRate) {
+  SleepingStep loop(std::chrono::milliseconds(2),
+                    PeriodicRunnable::OverrunPolicy::kSkip,
+                    std::chrono::nanoseconds(0), 0);
+  const auto start = std::chrono::steady_clock::now();
+  loop.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  loop.Stop();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  const auto statistics = loop.GetStatistics();
+  ASSERT_EQ(loop.Count(), statistics.steps);
+  // 100 periods, with a large margin for a loaded machine.
+  ASSERT_GE(statistics.steps, 50u);
+  // At most one step per deadline that passed while the loop ran.
+  const auto periods = elapsed / std::chrono::milliseconds(2);
+  ASSERT_LE(statistics.steps, static_cast<uint64_t>(periods) + 1);
+  ASSERT_LE(statistics.skipped, statistics.steps / 10);
+}
+
+TEST(PeriodicRunnable, skipPolicyDropsTheMissedSteps) {
+  // Each step lasts two and a half periods.
+  SleepingStep loop(std::chrono::milliseconds(10),
+                    PeriodicRunnable::OverrunPolicy::kSkip,
+                    std::chrono::milliseconds(25), 1000);
+  loop.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  loop.Stop();
+
+  const auto statistics = loop.GetStatistics();
+  ASSERT_GT(statistics.steps, 0u);
+  ASSERT_EQ(statistics.steps, statistics.overruns);
+  ASSERT_GE(statistics.skipped, 2 * statistics.steps);
+  ASSERT_GE(statistics.max_step_time, std::chrono::milliseconds(25));
+}
+
+TEST(PeriodicRunnable, catchUpPolicyRunsTheMissedSteps) {
+  // The first step lasts ten periods, the next ones catch up.
+  SleepingStep loop(std::chrono::milliseconds(5),
+                    PeriodicRunnable::OverrunPolicy::kCatchUp,
+                    std::chrono::milliseconds(50), 1);
+  loop.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  loop.Stop();
+
+  const auto statistics = loop.GetStatistics();
+  ASSERT_GE(statistics.overruns, 1u);
+  ASSERT_EQ(0u, statistics.skipped);
+  // Back on the grid: about 40 periods elapsed.
+  ASSERT_GE(statistics.steps, 25u);
+  ASSERT_GE(statistics.max_jitter, std::chrono::milliseconds(40));
+}
+
+TEST(PeriodicRunnable, stopWakesTheSleep) {
+  SleepingStep loop(std::chrono::seconds(10),
+                    PeriodicRunnable::OverrunPolicy::kSkip,
+                    std::chrono::nanoseconds(0), 0);
+  loop.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  const auto start = std::chrono::steady_clock::now();
+  loop.Stop();
+  // Far less than the 10 s period, even on a loaded machine.
+  ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+  ASSERT_EQ(0u, loop.Count());
+}
+
+TEST(PeriodicRunnableBenchmark, jitterAt1kHz) {
+  SleepingStep loop(std::chrono::milliseconds(1),
+                    PeriodicRunnable::OverrunPolicy::kSkip,
+                    std::chrono::nanoseconds(0), 0);
+  loop.Start();
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  loop.Stop();
+
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  const auto statistics = loop.GetStatistics();
+  std::cout << "[ BENCHMARK] 1 kHz loop: " << statistics.steps << " steps, "
+            << statistics.overruns << " overruns, jitter mean "
+            << duration_cast<microseconds>(statistics.mean_jitter).count()
+            << " us, max "
+            << duration_cast<microseconds>(statistics.max_jitter).count()
+            << " us" << std::endl;
+  ASSERT_GT(statistics.steps, 0u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -25,6 +25,177 @@
 
 #include "gtest/gtest.h"
 #include <sonia_common/pattern/runnable.h>
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <system_error>
+
+class ConfiguredRunnable : public sonia_common::Runnable {
+ public:
+  explicit ConfiguredRunnable(const sonia_common::ThreadOptions &options)
+      : sonia_common::Runnable(options) {}
+
+  std::atomic<bool> ran_ = {false};
+  std::string name_ = {""};
+  int cpu_count_ = {0};
+  bool on_cpu_zero_ = {false};
+
+ protected:
+  void Run() override {
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    name_ = name;
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    cpu_count_ = CPU_COUNT(&cpu_set);
+    on_cpu_zero_ = CPU_ISSET(0, &cpu_set);
+    ran_ = true;
+
+    while (!MustStop()) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+TEST(Runnable, appliesThreadOptions) {
+  sonia_common::ThreadOptions options;
+  options.cpus = {0};
+  options.name = "a_very_long_runnable_name";
+
+  ConfiguredRunnable runnable(options);
+  runnable.Start();
+  while (!runnable.ran_) {
+    std::this_thread::yield();
+  }
+  runnable.Stop();
+
+  ASSERT_EQ(runnable.name_, "a_very_long_run");
+  ASSERT_EQ(runnable.cpu_count_, 1);
+  ASSERT_TRUE(runnable.on_cpu_zero_);
+}
+
+TEST(Runnable, invalidThreadOptionsThrowOnStart) {
+  sonia_common::ThreadOptions options;
+  options.cpus = {-1};
+
+  ConfiguredRunnable runnable(options);
+  ASSERT_THROW(runnable.Start(), std::system_error);
+  ASSERT_FALSE(runnable.ran_);
+  ASSERT_FALSE(runnable.IsRunning());
+}
+
+class SleepingRunnable : public sonia_common::Runnable {
+ public:
+  std::atomic<bool> sleeping_ = {false};
+  std::atomic<bool> woken_ = {false};
+
+ protected:
+  void Run() override {
+    sleeping_ = true;
+    woken_ = !WaitFor(std::chrono::seconds(30));
+  }
+};
+
+TEST(Runnable, stopWakesTheWait) {
+  SleepingRunnable runnable;
+  runnable.Start();
+  while (!runnable.sleeping_) {
+    std::this_thread::yield();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  runnable.Stop();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_TRUE(runnable.woken_);
+  ASSERT_LT(elapsed, std::chrono::seconds(1));
+}
+
+TEST(Runnable, waitElapsesWithoutStop) {
+  struct WaitingRunnable : public sonia_common::Runnable {
+    std::atomic<bool> elapsed_ = {false};
+    void Run() override {
+      elapsed_ = WaitFor(std::chrono::milliseconds(1));
+      while (!MustStop()) {
+        std::this_thread::yield();
+      }
+    }
+  } runnable;
+  runnable.Start();
+  while (!runnable.elapsed_) {
+    std::this_thread::yield();
+  }
+  runnable.Stop();
+}
+
+TEST(Runnable, canBeRestarted) {
+  SleepingRunnable runnable;
+  runnable.Start();
+  runnable.Stop();
+  runnable.sleeping_ = false;
+  runnable.woken_ = false;
+
+  runnable.Start();
+  ASSERT_TRUE(runnable.IsRunning());
+  while (!runnable.sleeping_) {
+    std::this_thread::yield();
+  }
+  // The stop event was rearmed as well, the wait does not return early.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASSERT_FALSE(runnable.woken_);
+  runnable.Stop();
+  ASSERT_TRUE(runnable.woken_);
+}
+
+class ProfiledRunnable : public sonia_common::Runnable {
+ public:
+  explicit ProfiledRunnable(const sonia_common::ThreadOptions &options)
+      : sonia_common::Runnable(options) {}
+
+ protected:
+  void Run() override {
+    do {
+      Heartbeat();
+      // Half of the loop on the CPU, half asleep.
+      auto end =
+          std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+      while (std::chrono::steady_clock::now() < end) {
+      }
+    } while (WaitFor(std::chrono::milliseconds(1)));
+  }
+};
+
+TEST(Runnable, profilesTheThread) {
+  sonia_common::ThreadOptions options;
+  options.name = "profiled";
+  ProfiledRunnable runnable(options);
+  runnable.Start();
+  ASSERT_THROW(runnable.GetProfile(), std::logic_error);
+
+  runnable.EnableProfiling();
+  // At least two heartbeats make a loop, however loaded the machine is.
+  auto profile = runnable.GetProfile();
+  for (int i = 0; i < 2000 && profile.loops == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    profile = runnable.GetProfile();
+  }
+  runnable.Stop();
+
+  ASSERT_EQ(profile.name, "profiled");
+  ASSERT_GT(profile.tid, 0);
+  ASSERT_GT(profile.elapsed, std::chrono::steady_clock::duration::zero());
+  ASSERT_GT(profile.cpu_usage, 0.0);
+  ASSERT_GT(profile.loops, 0u);
+  // Each loop spins for a millisecond.
+  ASSERT_GE(profile.p50_loop_time, std::chrono::milliseconds(1));
+  ASSERT_GE(profile.p99_loop_time, profile.p50_loop_time);
+  ASSERT_GE(profile.max_loop_time, profile.p99_loop_time);
+  ASSERT_EQ(0u, profile.ToString().find("[profiled] tid "));
+}
 
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
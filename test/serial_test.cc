@@ -37,6 +37,9 @@
 #include "gtest/gtest.h"
 #include <boost/bind.hpp>
 #include <sonia_common/io/serial.h>
+#include <sonia_common/pattern/runnable.h>
+#include <atomic>
+#include <chrono>
 
 #if defined(OS_LINUX)
 #include <pty.h>
@@ -112,6 +115,40 @@ TEST_F(SerialTests, partialRead) {
   EXPECT_EQ(r, std::string("abc\n"));
 }
 
+class SerialReader : public Runnable {
+ public:
+  explicit SerialReader(Serial &port) : port_(port) {}
+
+  std::atomic<bool> waiting_ = {false};
+
+ protected:
+  void Run() override {
+    while (!MustStop()) {
+      waiting_ = true;
+      if (port_.WaitReadable(GetStopEvent())) {
+        port_.Read(port_.Available());
+      }
+    }
+  }
+
+ private:
+  Serial &port_;
+};
+
+TEST_F(SerialTests, stopWakesWaitReadable) {
+  port1->SetTimeout(Timeout::SimpleTimeout(30000));
+  SerialReader reader(*port1);
+  reader.Start();
+  while (!reader.waiting_) {
+    std::this_thread::yield();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  reader.Stop();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, std::chrono::seconds(1));
+}
+
 }  // namespace
 
 int main(int argc, char **argv) {
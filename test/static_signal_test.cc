@@ -0,0 +1,175 @@
+/**
+ * \file	static_signal_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/observer.h>
+#include <sonia_common/pattern/static_signal.h>
+#include <sonia_common/pattern/subject.h>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace sonia_common;
+
+namespace {
+
+struct Sample {
+  double values[3];
+};
+
+class Accumulator {
+ public:
+  double sum = 0;
+
+  void OnSample(const Sample &sample) { sum += sample.values[0]; }
+};
+
+class AccumulatorObserver : public Observer<const Sample &> {
+ public:
+  double sum = 0;
+
+ protected:
+  void OnSubjectNotify(Subject<const Sample &> &,
+                       const Sample &sample) override {
+    sum += sample.values[0];
+  }
+};
+
+}  // namespace
+
+TEST(StaticSignal, delegateCallsLambdaAndMethod) {
+  Accumulator accumulator;
+  int calls = 0;
+  Delegate<void(const Sample &)> lambda(
+      [&calls](const Sample &) { ++calls; });
+  Delegate<void(const Sample &)> method(accumulator, &Accumulator::OnSample);
+  Delegate<void(const Sample &)> empty;
+
+  Sample sample = {{2., 0., 0.}};
+  lambda(sample);
+  method(sample);
+  ASSERT_EQ(1, calls);
+  ASSERT_EQ(2., accumulator.sum);
+  ASSERT_TRUE(static_cast<bool>(lambda));
+  ASSERT_FALSE(static_cast<bool>(empty));
+}
+
+TEST(StaticSignal, inlineSignalConnectAndDisconnect) {
+  InlineSignal<3, int> signal;
+  std::vector<int> calls;
+  auto first = signal.Connect([&calls](int i) { calls.push_back(i); });
+  auto second = signal.Connect([&calls](int i) { calls.push_back(10 * i); });
+  signal.Notify(1);
+  ASSERT_EQ(std::vector<int>({1, 10}), calls);
+
+  signal.Disconnect(first);
+  ASSERT_THROW(signal.Disconnect(first), std::out_of_range);
+  signal.Notify(2);
+  ASSERT_EQ(std::vector<int>({1, 10, 20}), calls);
+
+  // The identifier of a disconnected slot is reused.
+  ASSERT_EQ(first, signal.Connect([&calls](int i) { calls.push_back(-i); }));
+  signal.Connect([](int) {});
+  ASSERT_EQ(3u, signal.SlotCount());
+  ASSERT_THROW(signal.Connect([](int) {}), std::length_error);
+
+  signal.Disconnect(second);
+  calls.clear();
+  signal.Notify(3);
+  ASSERT_EQ(std::vector<int>({-3}), calls);
+}
+
+TEST(StaticSignal, staticSignalCallsEverySlotInOrder) {
+  std::vector<int> calls;
+  auto signal =
+      MakeStaticSignal([&calls](int i) { calls.push_back(i); },
+                       [&calls](int i) { calls.push_back(2 * i); });
+  ASSERT_EQ(2u, signal.SlotCount());
+  signal.Notify(4);
+  ASSERT_EQ(std::vector<int>({4, 8}), calls);
+}
+
+TEST(StaticSignalBenchmark, compareWithObserver) {
+  const int kNotifications = 10000000;
+  const int kSlots = 4;
+  Sample sample = {{1., 0., 0.}};
+
+  auto report = [](const char *name,
+                   std::chrono::steady_clock::duration elapsed, double sum) {
+    std::cout << "[ BENCHMARK] " << name << ": "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                         .count() / static_cast<double>(kNotifications)
+              << " ns per notification (sum " << sum << ")" << std::endl;
+  };
+
+  {
+    Subject<const Sample &> subject;
+    std::vector<std::unique_ptr<AccumulatorObserver>> observers;
+    for (int i = 0; i < kSlots; ++i) {
+      observers.emplace_back(new AccumulatorObserver());
+      observers.back()->Observe(subject);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNotifications; ++i) {
+      subject.Notify(sample);
+    }
+    report("Subject      ", std::chrono::steady_clock::now() - start,
+           observers[0]->sum);
+  }
+  {
+    InlineSignal<kSlots, const Sample &> signal;
+    Accumulator accumulators[kSlots];
+    for (auto &accumulator : accumulators) {
+      signal.Connect(accumulator, &Accumulator::OnSample);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNotifications; ++i) {
+      signal.Notify(sample);
+    }
+    report("InlineSignal ", std::chrono::steady_clock::now() - start,
+           accumulators[0].sum);
+  }
+  {
+    Accumulator accumulators[kSlots];
+    auto signal = MakeStaticSignal(
+        [&](const Sample &s) { accumulators[0].OnSample(s); },
+        [&](const Sample &s) { accumulators[1].OnSample(s); },
+        [&](const Sample &s) { accumulators[2].OnSample(s); },
+        [&](const Sample &s) { accumulators[3].OnSample(s); });
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNotifications; ++i) {
+      signal.Notify(sample);
+    }
+    report("StaticSignal ", std::chrono::steady_clock::now() - start,
+           accumulators[0].sum);
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,256 @@
+/**
+ * \file	supervisor_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/observer.h>
+#include <sonia_common/pattern/supervisor.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sonia_common;
+
+namespace {
+
+/**
+ * Beats every millisecond, but hangs -- without heartbeat -- for its first
+ * hung_runs runs, or when hang_ is set. A hung run takes stop_delay to
+ * notice Stop().
+ */
+class Loop : public Runnable {
+ public:
+  explicit Loop(int hung_runs = 0,
+                std::chrono::milliseconds stop_delay =
+                    std::chrono::milliseconds(0))
+      : hung_runs_(hung_runs), stop_delay_(stop_delay) {}
+
+  ~Loop() {
+    if (IsRunning()) {
+      Stop();
+    }
+  }
+
+  std::atomic<bool> hang_ = {false};
+  std::atomic<int> runs_ = {0};
+
+ protected:
+  void Run() override {
+    const bool hung = runs_++ < hung_runs_;
+    while (WaitFor(std::chrono::milliseconds(1))) {
+      if (!hung && !hang_) {
+        Heartbeat();
+      }
+    }
+    if (hung) {
+      std::this_thread::sleep_for(stop_delay_);
+    }
+  }
+
+ private:
+  const int hung_runs_;
+  const std::chrono::milliseconds stop_delay_;
+};
+
+class FaultObserver : public Observer<const SupervisorFault &> {
+ public:
+  std::atomic<int> faults_ = {0};
+  std::string name_;
+
+  void OnSubjectNotify(Subject<const SupervisorFault &> &,
+                       const SupervisorFault &fault) override {
+    name_ = fault.name;
+    ++faults_;
+  }
+};
+
+std::vector<std::string> lines;
+
+void Log(const std::string &line) { lines.push_back(line); }
+
+template <class Predicate_>
+bool WaitUntil(Predicate_ predicate) {
+  for (int i = 0; i < 2000 && !predicate(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return predicate();
+}
+
+}  // namespace
+
+TEST(Supervisor, rejectsInvalidWatches) {
+  Supervisor supervisor;
+  Loop loop;
+  Supervisor::WatchOptions options;
+  options.timeout = Supervisor::Clock::duration::zero();
+  ASSERT_THROW(supervisor.Watch(loop, options), std::invalid_argument);
+  supervisor.Watch(loop);
+  ASSERT_THROW(supervisor.Watch(loop), std::invalid_argument);
+  ASSERT_TRUE(supervisor.IsWatching(loop));
+  supervisor.Unwatch(loop);
+  ASSERT_THROW(supervisor.Unwatch(loop), std::out_of_range);
+}
+
+TEST(Supervisor, publishesAFaultOnAStall) {
+  lines.clear();
+  Supervisor supervisor(std::chrono::milliseconds(2), Log);
+  FaultObserver observer;
+  observer.Observe(supervisor);
+  Loop loop;
+  Supervisor::WatchOptions options;
+  options.name = "vision";
+  options.timeout = std::chrono::milliseconds(20);
+  options.action = Supervisor::Action::kFault;
+  supervisor.Watch(loop, options);
+  loop.Start();
+  supervisor.Start();
+
+  ASSERT_TRUE(WaitUntil([&] {
+    return supervisor.GetStatistics()[0].heartbeats > 10;
+  }));
+  ASSERT_EQ(0, observer.faults_);
+
+  loop.hang_ = true;
+  ASSERT_TRUE(WaitUntil([&] { return observer.faults_ > 0; }));
+  supervisor.Stop();
+
+  const auto statistics = supervisor.GetStatistics()[0];
+  ASSERT_EQ(1, observer.faults_);
+  ASSERT_EQ("vision", observer.name_);
+  ASSERT_EQ(1u, statistics.stalls);
+  ASSERT_TRUE(statistics.stalled);
+  ASSERT_GE(statistics.max_silence, std::chrono::milliseconds(20));
+  ASSERT_EQ(1u, lines.size());
+  ASSERT_EQ(0u, lines[0].find("[supervisor] vision: no heartbeat for"));
+}
+
+TEST(Supervisor, restartsAStalledRunnable) {
+  Supervisor supervisor(std::chrono::milliseconds(2), Log);
+  Loop loop(1);
+  Supervisor::WatchOptions options;
+  options.timeout = std::chrono::milliseconds(20);
+  options.action = Supervisor::Action::kRestart;
+  supervisor.Watch(loop, options);
+  loop.Start();
+  supervisor.Start();
+
+  ASSERT_TRUE(WaitUntil([&] {
+    return supervisor.GetStatistics()[0].heartbeats > 10;
+  }));
+  supervisor.Stop();
+
+  const auto statistics = supervisor.GetStatistics()[0];
+  ASSERT_EQ(2, loop.runs_);
+  ASSERT_EQ(1u, statistics.restarts);
+  ASSERT_FALSE(statistics.stalled);
+  ASSERT_TRUE(loop.IsRunning());
+}
+
+TEST(Supervisor, measuresTheLoopRate) {
+  Supervisor supervisor(std::chrono::milliseconds(5), Log);
+  Loop loop;
+  supervisor.Watch(loop);
+  loop.Start();
+  supervisor.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  supervisor.Stop();
+
+  // About 1 kHz, but the machine may be loaded.
+  const auto statistics = supervisor.GetStatistics()[0];
+  ASSERT_GT(statistics.heartbeats, 0u);
+  ASSERT_GT(statistics.rate, 0.0);
+  ASSERT_GE(statistics.max_silence, statistics.silence);
+}
+
+TEST(Supervisor, staysAvailableDuringASlowRestart) {
+  Supervisor supervisor(std::chrono::milliseconds(2), Log);
+  Loop loop(1, std::chrono::milliseconds(300));
+  Supervisor::WatchOptions options;
+  options.timeout = std::chrono::milliseconds(20);
+  options.action = Supervisor::Action::kRestart;
+  supervisor.Watch(loop, options);
+  loop.Start();
+  supervisor.Start();
+
+  // The stall is visible while the Runnable is still stopping.
+  ASSERT_TRUE(WaitUntil([&] {
+    return supervisor.GetStatistics()[0].stalls > 0;
+  }));
+  ASSERT_EQ(0u, supervisor.GetStatistics()[0].restarts);
+  ASSERT_TRUE(supervisor.IsWatching(loop));
+
+  ASSERT_TRUE(WaitUntil([&] {
+    return supervisor.GetStatistics()[0].restarts > 0;
+  }));
+  supervisor.Stop();
+  ASSERT_EQ(2, loop.runs_);
+  supervisor.Unwatch(loop);
+}
+
+TEST(Supervisor, keepsCheckingDuringAWedgedRestart) {
+  lines.clear();
+  Supervisor supervisor(std::chrono::milliseconds(2), Log);
+  FaultObserver observer;
+  observer.Observe(supervisor);
+  // Takes a second to notice Stop(), as if it were stuck in a read.
+  Loop wedged(1, std::chrono::milliseconds(1000));
+  Loop vision;
+  Supervisor::WatchOptions options;
+  options.name = "reader";
+  options.timeout = std::chrono::milliseconds(20);
+  options.action = Supervisor::Action::kRestart;
+  supervisor.Watch(wedged, options);
+  options.name = "vision";
+  options.action = Supervisor::Action::kFault;
+  supervisor.Watch(vision, options);
+  wedged.Start();
+  vision.Start();
+  supervisor.Start();
+
+  // The fault is published before the restart completes.
+  ASSERT_TRUE(WaitUntil([&] { return observer.faults_ > 0; }));
+  ASSERT_EQ(0u, supervisor.GetStatistics()[0].restarts);
+
+  // The other Runnable is still checked while the restart hangs.
+  vision.hang_ = true;
+  ASSERT_TRUE(WaitUntil([&] { return observer.faults_ > 1; }));
+  ASSERT_EQ(0u, supervisor.GetStatistics()[0].restarts);
+
+  ASSERT_TRUE(WaitUntil([&] {
+    return supervisor.GetStatistics()[0].restarts > 0;
+  }));
+  supervisor.Stop();
+  ASSERT_EQ(2, wedged.runs_);
+  ASSERT_EQ(0u, lines[0].find("[supervisor] reader: no heartbeat for"));
+  ASSERT_NE(std::string::npos, lines[0].find(", restarting"));
+  ASSERT_EQ("[supervisor] reader: restarted", lines.back());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+/**
+ * \file	task_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/task.h>
+#include <sonia_common/pattern/thread_pool.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+//==============================================================================
+// Every allocation of this test program goes through these operators so we
+// can count the allocations made while tasks are flowing through the pool.
+
+namespace {
+
+std::atomic<size_t> allocation_count(0);
+
+}  // namespace
+
+void *operator new(size_t size) {
+  ++allocation_count;
+  void *pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, size_t) noexcept { std::free(pointer); }
+
+//==============================================================================
+
+using sonia_common::Task;
+using sonia_common::ThreadPool;
+
+TEST(Task, smallCallableIsInline) {
+  int value = 0;
+  size_t before = allocation_count;
+  Task task([&value] { value = 42; });
+  ASSERT_EQ(allocation_count, before);
+  ASSERT_TRUE(task.IsInline());
+
+  Task moved(std::move(task));
+  ASSERT_FALSE(static_cast<bool>(task));
+  ASSERT_TRUE(static_cast<bool>(moved));
+  moved();
+  ASSERT_EQ(value, 42);
+}
+
+TEST(Task, bigCallableGoesOnHeap) {
+  char payload[128] = {};
+  payload[127] = 7;
+  int value = 0;
+  Task task([payload, &value] { value = payload[127]; });
+  ASSERT_FALSE(task.IsInline());
+
+  Task assigned;
+  assigned = std::move(task);
+  assigned();
+  ASSERT_EQ(value, 7);
+}
+
+TEST(Task, holdsMoveOnlyCallable) {
+  std::packaged_task<int()> packaged([] { return 3; });
+  auto future = packaged.get_future();
+  Task task(std::move(packaged));
+  task();
+  ASSERT_EQ(future.get(), 3);
+}
+
+TEST(ThreadPool, enqueueDetachedDoesNotAllocate) {
+  const ThreadPool::Backend backends[] = {ThreadPool::Backend::kSharedQueue,
+                                          ThreadPool::Backend::kWorkStealing,
+                                          ThreadPool::Backend::kLockFreeRing};
+  for (auto backend : backends) {
+    ThreadPool::Options options;
+    options.backend = backend;
+    ThreadPool pool(2, options);
+    std::atomic<size_t> done(0);
+
+    const size_t batch = 1000;
+    auto run_batch = [&] {
+      size_t target = done + batch;
+      for (size_t i = 0; i < batch; ++i) {
+        pool.EnqueueDetached([&done] { ++done; });
+      }
+      while (done < target) {
+        std::this_thread::yield();
+      }
+    };
+
+    // The first batches let the queues reach their working size.
+    run_batch();
+    run_batch();
+
+    size_t before = allocation_count;
+    for (int i = 0; i < 10; ++i) {
+      run_batch();
+    }
+    size_t allocations = allocation_count - before;
+    ASSERT_EQ(allocations, 0u);
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,100 @@
+/**
+ * \file	thread_pool_metrics_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define SONIA_THREAD_POOL_METRICS
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/thread_pool.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using sonia_common::Task;
+using sonia_common::ThreadPool;
+
+static_assert(sizeof(Task) <= 64, "the enqueue time must fit in the Task");
+
+TEST(ThreadPoolMetrics, recordsWaitAndRunTimes) {
+  ASSERT_TRUE(ThreadPool::HasMetrics());
+  const ThreadPool::Backend backends[] = {ThreadPool::Backend::kSharedQueue,
+                                          ThreadPool::Backend::kWorkStealing,
+                                          ThreadPool::Backend::kLockFreeRing};
+  for (auto backend : backends) {
+    ThreadPool::Options options;
+    options.backend = backend;
+    ThreadPool pool(2, options);
+
+    // The first task keeps a worker busy while the other ones pile up.
+    std::atomic<bool> release(false);
+    pool.EnqueueDetached([&release] {
+      while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+    std::atomic<int> done(0);
+    for (int i = 0; i < 20; ++i) {
+      pool.EnqueueWithPriority(ThreadPool::Priority::kLow, [&done] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++done;
+      });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    release = true;
+    while (done < 20) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // Let the workers account for the last task.
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    auto metrics = pool.GetMetrics();
+    ASSERT_EQ(21u, metrics.run_time.count);
+    ASSERT_EQ(21u, metrics.wait_time.count);
+    ASSERT_GE(metrics.queue_high_water_mark, 10u);
+    ASSERT_GE(metrics.run_time.max, std::chrono::milliseconds(10));
+    ASSERT_GE(metrics.run_time.Percentile(0.5), std::chrono::milliseconds(1));
+    ASSERT_LE(metrics.run_time.Percentile(0.5), metrics.run_time.max);
+    ASSERT_GE(metrics.wait_time.max, std::chrono::milliseconds(5));
+    ASSERT_GT(metrics.elapsed, metrics.run_time.max);
+
+    ASSERT_EQ(2u, metrics.worker_busy_ratio.size());
+    double busy = 0;
+    for (auto ratio : metrics.worker_busy_ratio) {
+      ASSERT_GE(ratio, 0.);
+      ASSERT_LE(ratio, 1.);
+      busy += ratio;
+    }
+    ASSERT_GT(busy, 0.2);
+
+    pool.ResetMetrics();
+    metrics = pool.GetMetrics();
+    ASSERT_EQ(0u, metrics.run_time.count);
+    ASSERT_EQ(0u, metrics.queue_high_water_mark);
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,563 @@
+/**
+ * \file	thread_pool_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <sonia_common/pattern/thread_pool.h>
+#include <sonia_common/sys/timer.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+
+using sonia_common::ThreadPool;
+
+namespace {
+
+ThreadPool::Options BackendOptions(ThreadPool::Backend backend) {
+  ThreadPool::Options options;
+  options.backend = backend;
+  return options;
+}
+
+const ThreadPool::Backend kBackends[] = {ThreadPool::Backend::kSharedQueue,
+                                         ThreadPool::Backend::kWorkStealing,
+                                         ThreadPool::Backend::kLockFreeRing};
+
+const char *BackendName(ThreadPool::Backend backend) {
+  switch (backend) {
+    case ThreadPool::Backend::kWorkStealing:
+      return "work stealing ";
+    case ThreadPool::Backend::kLockFreeRing:
+      return "lock-free ring";
+    default:
+      return "shared queue  ";
+  }
+}
+
+/**
+ * Enqueue tasks_per_producer tiny tasks from each producer thread and return
+ * the throughput in tasks per millisecond.
+ */
+double MeasureThroughput(ThreadPool::Backend backend, size_t workers,
+                         size_t producers, size_t tasks_per_producer) {
+  std::atomic<size_t> done(0);
+  sonia_common::MicroTimer timer;
+  {
+    ThreadPool pool(workers, BackendOptions(backend));
+    timer.Start();
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&] {
+        for (size_t i = 0; i < tasks_per_producer; ++i) {
+          pool.Enqueue([&done] { ++done; });
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  timer.Pause();
+  EXPECT_EQ(done, producers * tasks_per_producer);
+  return static_cast<double>(done) * 1000. /
+         std::max<int64_t>(timer.MicroSeconds(), 1);
+}
+
+}  // namespace
+
+TEST(ThreadPool, enqueueReturnsResult) {
+  for (auto backend : kBackends) {
+    ThreadPool pool(4, BackendOptions(backend));
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i) {
+      results.emplace_back(pool.Enqueue([](int v) { return v * v; }, i));
+    }
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_EQ(results[i].get(), i * i);
+    }
+  }
+}
+
+TEST(ThreadPool, destructorDrainsTasks) {
+  for (auto backend : kBackends) {
+    std::atomic<int> count(0);
+    {
+      ThreadPool pool(2, BackendOptions(backend));
+      for (int i = 0; i < 1000; ++i) {
+        pool.Enqueue([&count] { ++count; });
+      }
+    }
+    ASSERT_EQ(count, 1000);
+  }
+}
+
+TEST(ThreadPool, nestedEnqueueFromWorker) {
+  ThreadPool pool(4, BackendOptions(ThreadPool::Backend::kWorkStealing));
+  std::atomic<int> count(0);
+  std::vector<std::future<void>> inner;
+  std::mutex inner_mutex;
+
+  auto outer = pool.Enqueue([&] {
+    for (int i = 0; i < 64; ++i) {
+      auto future = pool.Enqueue([&count] { ++count; });
+      std::lock_guard<std::mutex> lock(inner_mutex);
+      inner.emplace_back(std::move(future));
+    }
+  });
+  outer.get();
+  for (auto &future : inner) {
+    future.get();
+  }
+  ASSERT_EQ(count, 64);
+  ASSERT_EQ(pool.GetBackend(), ThreadPool::Backend::kWorkStealing);
+}
+
+TEST(ThreadPool, workersApplyThreadOptions) {
+  ThreadPool::Options options;
+  options.thread_options.name = "pool_test";
+  options.thread_options.cpus = {0};
+  ThreadPool pool(2, options);
+
+  auto name = pool.Enqueue([] {
+                    char buffer[16] = {};
+                    pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+                    return std::string(buffer);
+                  }).get();
+  ASSERT_EQ(name.find("pool_test/"), 0u);
+
+  options.thread_options.cpus = {-1};
+  ASSERT_THROW(ThreadPool(2, options), std::system_error);
+}
+
+TEST(ThreadPool, priorityAndDeadlineOrder) {
+  for (auto backend : kBackends) {
+    ThreadPool pool(1, BackendOptions(backend));
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    pool.Enqueue([opened] { opened.wait(); });
+
+    // Let the worker pick the gate task before queueing the other ones.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::mutex order_mutex;
+    std::vector<int> order;
+    auto record = [&](int id) {
+      std::lock_guard<std::mutex> lock(order_mutex);
+      order.push_back(id);
+    };
+
+    auto now = ThreadPool::Clock::now();
+    std::vector<std::future<void>> futures;
+    // Only one task goes in the normal lane: the work stealing backend does
+    // not keep the FIFO order of the tasks of a single worker.
+    futures.push_back(pool.EnqueueWithPriority(ThreadPool::Priority::kLow,
+                                               record, 5));
+    futures.push_back(pool.EnqueueWithPriority(ThreadPool::Priority::kNormal,
+                                               record, 4));
+    futures.push_back(pool.EnqueueWithPriority(ThreadPool::Priority::kHigh,
+                                               record, 3));
+    futures.push_back(pool.EnqueueWithDeadline(
+        now + std::chrono::seconds(10), record, 2));
+    futures.push_back(pool.EnqueueWithDeadline(
+        now + std::chrono::seconds(1), record, 1));
+
+    gate.set_value();
+    for (auto &future : futures) {
+      future.get();
+    }
+    ASSERT_EQ(order, (std::vector<int>{1, 2, 3, 4, 5}));
+  }
+}
+
+TEST(ThreadPool, deadlineStatistics) {
+  ThreadPool pool(1);
+  auto past = ThreadPool::Clock::now() - std::chrono::milliseconds(1);
+  pool.EnqueueWithDeadline(past, [] {}).get();
+  pool.EnqueueWithDeadline(ThreadPool::Clock::now() +
+                               std::chrono::milliseconds(5),
+                           [] {
+                             std::this_thread::sleep_for(
+                                 std::chrono::milliseconds(20));
+                           }).get();
+  pool.EnqueueWithDeadline(
+          ThreadPool::Clock::now() + std::chrono::seconds(10), [] {}).get();
+
+  auto statistics = pool.GetDeadlineStatistics();
+  ASSERT_EQ(statistics.tasks, 3u);
+  ASSERT_EQ(statistics.late_starts, 1u);
+  ASSERT_EQ(statistics.misses, 2u);
+}
+
+TEST(ThreadPool, parallelForVisitsEveryIndexOnce) {
+  for (auto backend : kBackends) {
+    ThreadPool pool(3, BackendOptions(backend));
+    std::vector<std::atomic<int>> visits(10000);
+    for (auto &visit : visits) {
+      visit = 0;
+    }
+    pool.ParallelFor(size_t(0), visits.size(), size_t(0),
+                     [&visits](size_t i) { ++visits[i]; });
+    for (auto &visit : visits) {
+      ASSERT_EQ(visit, 1);
+    }
+
+    // An empty range must return right away.
+    pool.ParallelFor(5, 5, 1, [](int) { FAIL(); });
+  }
+}
+
+TEST(ThreadPool, parallelReduce) {
+  for (auto backend : kBackends) {
+    ThreadPool pool(3, BackendOptions(backend));
+    auto sum = pool.ParallelReduce(
+        int64_t(0), int64_t(100000), int64_t(128), int64_t(0),
+        [](int64_t i) { return i; },
+        [](int64_t a, int64_t b) { return a + b; });
+    ASSERT_EQ(sum, int64_t(100000) * 99999 / 2);
+
+    auto max = pool.ParallelReduce(0, 1000, 0, 0, [](int i) { return i % 97; },
+                                   [](int a, int b) { return std::max(a, b); });
+    ASSERT_EQ(max, 96);
+  }
+}
+
+TEST(ThreadPool, parallelForNestedAndExceptions) {
+  for (auto backend : kBackends) {
+    ThreadPool pool(2, BackendOptions(backend));
+    std::atomic<int> count(0);
+    pool.ParallelFor(0, 8, 1, [&](int) {
+      pool.ParallelFor(0, 100, 10, [&count](int) { ++count; });
+    });
+    ASSERT_EQ(count, 800);
+
+    ASSERT_THROW(pool.ParallelFor(0, 1000, 10,
+                                  [](int i) {
+                                    if (i == 500) {
+                                      throw std::runtime_error("failure");
+                                    }
+                                  }),
+                 std::runtime_error);
+  }
+}
+
+TEST(ThreadPool, parallelForDuringDestruction) {
+  for (auto backend : kBackends) {
+    std::atomic<bool> release(false);
+    std::atomic<int> count(0);
+    std::thread releaser([&release] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      release = true;
+    });
+    {
+      ThreadPool pool(1, BackendOptions(backend));
+      pool.EnqueueDetached([&] {
+        while (!release) {
+          std::this_thread::yield();
+        }
+        // The pool refuses the chunks by now, they run in this task.
+        pool.ParallelFor(0, 1000, 10, [&count](int) { ++count; });
+      });
+    }
+    releaser.join();
+    ASSERT_EQ(count, 1000);
+  }
+}
+
+/**
+ * Compare ParallelFor() with a serial loop and with one Enqueue() per
+ * element on a loop where each element costs a few hundred nanoseconds.
+ */
+TEST(ThreadPoolBenchmark, parallelFor) {
+  const size_t count = 100000;
+  std::vector<double> values(count);
+  auto work = [&values](size_t i) {
+    double value = static_cast<double>(i);
+    for (int j = 0; j < 32; ++j) {
+      value = std::sqrt(value + j);
+    }
+    values[i] = value;
+  };
+
+  ThreadPool pool(std::max<size_t>(std::thread::hardware_concurrency(), 2),
+                  BackendOptions(ThreadPool::Backend::kWorkStealing));
+  sonia_common::MicroTimer timer;
+
+  timer.Start();
+  for (size_t i = 0; i < count; ++i) {
+    work(i);
+  }
+  auto serial = timer.MicroSeconds();
+
+  timer.Start();
+  std::vector<std::future<void>> futures;
+  futures.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    futures.emplace_back(pool.Enqueue(work, i));
+  }
+  for (auto &future : futures) {
+    future.get();
+  }
+  auto naive = timer.MicroSeconds();
+
+  timer.Start();
+  pool.ParallelFor(size_t(0), count, size_t(0), work);
+  auto parallel = timer.MicroSeconds();
+
+  std::cout << "[ BENCHMARK] " << count << " elements, " << pool.Size()
+            << " workers: serial " << serial << "us, per element Enqueue "
+            << naive << "us, ParallelFor " << parallel << "us" << std::endl;
+}
+
+TEST(ThreadPool, lockFreeRingFull) {
+  auto options = BackendOptions(ThreadPool::Backend::kLockFreeRing);
+  options.ring_capacity = 4;
+  ThreadPool pool(2, options);
+
+  // Way more tasks than cells, enqueued both from outside and from inside the
+  // pool, where a full ring makes the worker run tasks itself.
+  std::atomic<int> count(0);
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 100; ++i) {
+    futures.push_back(pool.Enqueue([&] {
+      for (int j = 0; j < 10; ++j) {
+        pool.EnqueueDetached([&count] { ++count; });
+      }
+    }));
+  }
+  for (auto &future : futures) {
+    future.get();
+  }
+  while (count < 1000) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(count, 1000);
+}
+
+TEST(ThreadPool, scheduleAfterAndCancel) {
+  ThreadPool pool(2);
+  std::atomic<int> fired(0);
+  auto start = ThreadPool::Clock::now();
+  std::atomic<int64_t> delay(0);
+  auto handle =
+      pool.ScheduleAfter(std::chrono::milliseconds(20), [&fired, &delay, start] {
+        delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    ThreadPool::Clock::now() - start)
+                    .count();
+        ++fired;
+      });
+  auto cancelled = pool.ScheduleAfter(std::chrono::milliseconds(10),
+                                      [&fired] { fired += 100; });
+  cancelled.Cancel();
+  ASSERT_TRUE(cancelled.IsCancelled());
+  ASSERT_FALSE(handle.IsCancelled());
+
+  while (handle.GetStatistics().firings == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(1, fired.load());
+  ASSERT_GE(delay.load(), 20);
+  ASSERT_EQ(0u, cancelled.GetStatistics().firings);
+  ASSERT_GE(handle.GetStatistics().last_lateness.count(), 0);
+}
+
+TEST(ThreadPool, scheduleEveryKeepsPeriod) {
+  for (auto backend : kBackends) {
+    ThreadPool pool(2, BackendOptions(backend));
+    std::atomic<int> count(0);
+    const auto start = std::chrono::steady_clock::now();
+    auto handle = pool.ScheduleEvery(std::chrono::milliseconds(5),
+                                     [&count] { ++count; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    handle.Cancel();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    auto statistics = handle.GetStatistics();
+
+    // Twenty periods, minus what the scheduler of a loaded machine eats.
+    ASSERT_GE(statistics.firings + statistics.skipped, 15u);
+    // At most one firing per period that passed before the cancellation.
+    const auto periods = elapsed / std::chrono::milliseconds(5);
+    ASSERT_LE(statistics.firings, static_cast<uint64_t>(periods) + 1);
+    ASSERT_GE(statistics.max_lateness, statistics.last_lateness);
+    ASSERT_GE(statistics.total_lateness, statistics.max_lateness);
+
+    // Only a firing that was already starting can still complete.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_LE(handle.GetStatistics().firings, statistics.firings + 1);
+  }
+
+  ThreadPool pool(1);
+  ASSERT_THROW(pool.ScheduleEvery(ThreadPool::Clock::duration::zero(), [] {}),
+               std::invalid_argument);
+}
+
+namespace {
+
+template <class Predicate_>
+bool WaitUntil(Predicate_ predicate) {
+  for (int i = 0; i < 2000 && !predicate(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return predicate();
+}
+
+}  // namespace
+
+TEST(ThreadPool, elasticPoolGrowsAndShrinks) {
+  const ThreadPool::Backend backends[] = {ThreadPool::Backend::kSharedQueue,
+                                          ThreadPool::Backend::kLockFreeRing};
+  for (auto backend : backends) {
+    auto options = BackendOptions(backend);
+    options.max_threads = 4;
+    options.grow_queue_depth = 0;
+    options.idle_timeout = std::chrono::milliseconds(50);
+    ThreadPool pool(1, options);
+    ASSERT_EQ(1u, pool.Size());
+
+    // Every task blocks its worker, so each new one needs another worker.
+    std::atomic<bool> release(false);
+    std::atomic<int> started(0);
+    for (int i = 0; i < 6; ++i) {
+      pool.EnqueueDetached([&release, &started] {
+        ++started;
+        while (!release) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      });
+    }
+    EXPECT_TRUE(WaitUntil([&started] { return started == 4; }));
+    EXPECT_EQ(4u, pool.Size());
+    EXPECT_DOUBLE_EQ(1., pool.GetUtilization());
+
+    release = true;
+    ASSERT_TRUE(WaitUntil([&pool] { return pool.Size() == 1; }));
+    ASSERT_EQ(6, started.load());
+    ASSERT_DOUBLE_EQ(0., pool.GetUtilization());
+
+    // The retired slots are reused.
+    release = false;
+    for (int i = 0; i < 2; ++i) {
+      pool.EnqueueDetached([&release] {
+        while (!release) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      });
+    }
+    EXPECT_TRUE(WaitUntil([&pool] { return pool.Size() == 2; }));
+    release = true;
+  }
+}
+
+TEST(ThreadPool, elasticPoolGrowsOnWaitTime) {
+  ThreadPool::Options options;
+  options.max_threads = 2;
+  options.grow_queue_depth = 100;
+  options.grow_wait_time = std::chrono::milliseconds(20);
+  ThreadPool pool(1, options);
+
+  std::atomic<bool> release(false);
+  pool.EnqueueDetached([&release] {
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+
+  // The only worker has been busy on the same task for too long.
+  auto result = pool.Enqueue([] { return 1; });
+  EXPECT_EQ(1, result.get());
+  EXPECT_EQ(2u, pool.Size());
+  release = true;
+
+  options.backend = ThreadPool::Backend::kWorkStealing;
+  ASSERT_THROW(ThreadPool(1, options), std::invalid_argument);
+}
+
+/**
+ * Latency between the Enqueue() call and the start of the task, for a pool
+ * that is mostly idle, so the hand-over includes the wake-up of a worker.
+ */
+TEST(ThreadPoolBenchmark, handoffLatency) {
+  const size_t samples = 2000;
+  for (auto backend : kBackends) {
+    ThreadPool pool(2, BackendOptions(backend));
+    std::vector<int64_t> latencies(samples);
+    std::atomic<size_t> done(0);
+
+    for (size_t i = 0; i < samples; ++i) {
+      auto enqueued = ThreadPool::Clock::now();
+      pool.EnqueueDetached([&latencies, &done, enqueued, i] {
+        latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           ThreadPool::Clock::now() - enqueued)
+                           .count();
+        ++done;
+      });
+      while (done <= i) {
+        std::this_thread::yield();
+      }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "[ BENCHMARK] " << BackendName(backend)
+              << " handoff latency p50=" << latencies[samples / 2]
+              << "ns p99=" << latencies[samples * 99 / 100]
+              << "ns max=" << latencies.back() << "ns" << std::endl;
+  }
+}
+
+/**
+ * Contention benchmark of the three backends: the shared queue, the work
+ * stealing deques and the lock-free MPMC ring. There is one producer per
+ * worker and every task is trivial, so the numbers are dominated by the cost
+ * of handing a task from a producer to a worker.
+ */
+TEST(ThreadPoolBenchmark, contentionScaling) {
+  const size_t max_threads =
+      std::max<size_t>(std::thread::hardware_concurrency(), 2);
+  const size_t tasks_per_producer = 20000;
+
+  // The powers of two, and the core count itself even when it is not one.
+  std::vector<size_t> thread_counts;
+  for (size_t threads = 1; threads < max_threads; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(max_threads);
+
+  for (size_t threads : thread_counts) {
+    for (auto backend : kBackends) {
+      auto throughput =
+          MeasureThroughput(backend, threads, threads, tasks_per_producer);
+      std::cout << "[ BENCHMARK] " << BackendName(backend)
+                << " threads=" << threads << " " << throughput << " tasks/ms"
+                << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -25,6 +25,10 @@
 
 #include <gtest/gtest.h>
 #include <sonia_common/sys/timer.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
 
 using sonia_common::Timer;
 using sonia_common::MilliTimer;
@@ -119,6 +123,105 @@ TEST(timer_tests, overlapping_long_intervals) {
   }
 }
 
+template <class Timer_>
+class LockFreeTimerTest : public ::testing::Test {};
+
+using LockFreeTimers = ::testing::Types<sonia_common::LocalTimer<>,
+                                        sonia_common::AtomicTimer<>>;
+TYPED_TEST_CASE(LockFreeTimerTest, LockFreeTimers);
+
+TYPED_TEST(LockFreeTimerTest, startsPaused) {
+  TypeParam timer;
+  ASSERT_FALSE(timer.IsRunning());
+  ASSERT_EQ(0, timer.NanoSeconds());
+  ASSERT_THROW(timer.Pause(), std::logic_error);
+}
+
+TYPED_TEST(LockFreeTimerTest, measuresTheRunningTime) {
+  TypeParam timer;
+  const auto start = std::chrono::steady_clock::now();
+  timer.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASSERT_TRUE(timer.IsRunning());
+  ASSERT_GE(timer.MilliSeconds(), 10);
+  ASSERT_GE(timer.MicroSeconds(), 10000);
+  ASSERT_THROW(timer.Unpause(), std::logic_error);
+
+  timer.Pause();
+  const auto pause_start = std::chrono::steady_clock::now();
+  const auto paused = timer.NanoSeconds();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  ASSERT_EQ(paused, timer.NanoSeconds());
+  const auto pause_end = std::chrono::steady_clock::now();
+
+  timer.Unpause();
+  const auto running = timer.NanoSeconds();
+  const auto end = std::chrono::steady_clock::now();
+  ASSERT_GE(running, paused);
+  // The pause is not counted, however long the sleep took.
+  ASSERT_LE(running, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         (end - start) - (pause_end - pause_start))
+                         .count());
+
+  timer.Pause();
+  timer.Reset();
+  ASSERT_FALSE(timer.IsRunning());
+  ASSERT_EQ(0, timer.NanoSeconds());
+}
+
+TEST(AtomicTimerTest, canBeSharedBetweenThreads) {
+  sonia_common::AtomicTimer<> timer;
+  timer.Start();
+  std::atomic<bool> done(false);
+  std::atomic<int> failures(0);
+  std::thread reader([&] {
+    int64_t last = 0;
+    while (!done) {
+      // The running time excludes the pauses, but never goes back.
+      const int64_t now = timer.NanoSeconds();
+      if (now < last) {
+        ++failures;
+      }
+      last = now;
+    }
+  });
+  for (int i = 0; i < 10000; ++i) {
+    timer.Pause();
+    timer.Unpause();
+  }
+  done = true;
+  reader.join();
+  ASSERT_EQ(0, failures);
+}
+
+/**
+ * The cost of a reading of the elapsed time, for each kind of timer.
+ */
+template <class Timer_>
+double NanoSecondsPerCall(Timer_ &timer) {
+  const int kCalls = 1000000;
+  timer.Start();
+  int64_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kCalls; ++i) {
+    sum += timer.NanoSeconds();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  // Keep the readings from being optimized out.
+  EXPECT_GT(sum, 0);
+  return std::chrono::duration<double, std::nano>(elapsed).count() / kCalls;
+}
+
+TEST(TimerBenchmark, readingOverhead) {
+  sonia_common::NanoTimer timer;
+  sonia_common::LocalTimer<> local_timer;
+  sonia_common::AtomicTimer<> atomic_timer;
+  std::cout << "[ BENCHMARK] NanoSeconds(): Timer "
+            << NanoSecondsPerCall(timer) << " ns, LocalTimer "
+            << NanoSecondsPerCall(local_timer) << " ns, AtomicTimer "
+            << NanoSecondsPerCall(atomic_timer) << " ns" << std::endl;
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
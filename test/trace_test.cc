@@ -0,0 +1,167 @@
+/**
+ * \file	trace_test.cc
+ * \author	Club SONIA <club.sonia@etsmtl.net>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define SONIA_TRACE
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sonia_common/sys/trace.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace sonia_common;
+
+namespace {
+
+std::string TemporaryPath() {
+  char path[] = "/tmp/sonia_trace_XXXXXX";
+  int fd = mkstemp(path);
+  close(fd);
+  return path;
+}
+
+std::string ReadFile(const std::string &path) {
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+size_t Occurrences(const std::string &text, const std::string &pattern) {
+  size_t count = 0;
+  for (size_t i = text.find(pattern); i != std::string::npos;
+       i = text.find(pattern, i + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+void Filter() { SONIA_TRACE_SCOPE("filter"); }
+
+void Frame() {
+  SONIA_TRACE_SCOPE("frame");
+  Filter();
+  Filter();
+}
+
+}  // namespace
+
+TEST(Tracer, writesChromeTraceEvents) {
+  const std::string path = TemporaryPath();
+  auto &tracer = Tracer::Instance();
+  tracer.Open(path, std::chrono::milliseconds(1));
+  ASSERT_TRUE(tracer.IsOpen());
+  ASSERT_THROW(tracer.Open(path), std::logic_error);
+
+  Frame();
+  std::thread worker([] {
+    pthread_setname_np(pthread_self(), "worker");
+    Frame();
+  });
+  worker.join();
+  tracer.Close();
+  ASSERT_FALSE(tracer.IsOpen());
+
+  const std::string trace = ReadFile(path);
+  unlink(path.c_str());
+  ASSERT_EQ(0u, trace.find("{\"traceEvents\":[\n"));
+  ASSERT_EQ(trace.size() - 4, trace.rfind("\n]}\n"));
+  ASSERT_EQ(2u, Occurrences(trace, "\"name\":\"frame\",\"ph\":\"X\""));
+  ASSERT_EQ(4u, Occurrences(trace, "\"name\":\"filter\",\"ph\":\"X\""));
+  ASSERT_EQ(1u, Occurrences(trace, "\"args\":{\"name\":\"worker\"}"));
+  ASSERT_EQ(0u, tracer.DroppedCount());
+}
+
+TEST(Tracer, recordsNothingWhileClosed) {
+  Frame();
+  const std::string path = TemporaryPath();
+  auto &tracer = Tracer::Instance();
+  tracer.Open(path);
+  tracer.Close();
+
+  const std::string trace = ReadFile(path);
+  unlink(path.c_str());
+  ASSERT_EQ(0u, Occurrences(trace, "\"ph\":\"X\""));
+}
+
+TEST(Tracer, dropsTheSpansThatDoNotFit) {
+  const std::string path = TemporaryPath();
+  auto &tracer = Tracer::Instance();
+  tracer.Open(path, std::chrono::seconds(10), 8);
+  std::thread worker([] {
+    for (int i = 0; i < 100; ++i) {
+      SONIA_TRACE_SCOPE("span");
+    }
+  });
+  worker.join();
+  tracer.Close();
+
+  const std::string trace = ReadFile(path);
+  unlink(path.c_str());
+  ASSERT_EQ(92u, tracer.DroppedCount());
+  ASSERT_EQ(8u, Occurrences(trace, "\"name\":\"span\""));
+}
+
+TEST(TracerBenchmark, spanOverhead) {
+  const int kRounds = 100;
+  const int kSpans = 1000;
+  auto measure = [&]() {
+    std::chrono::steady_clock::duration total{};
+    for (int round = 0; round < kRounds; ++round) {
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < kSpans; ++i) {
+        SONIA_TRACE_SCOPE("span");
+      }
+      total += std::chrono::steady_clock::now() - start;
+      // Let the tracer drain the buffer.
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return std::chrono::duration<double, std::nano>(total).count() /
+           (kRounds * kSpans);
+  };
+
+  auto &tracer = Tracer::Instance();
+  const double closed = measure();
+  const std::string path = TemporaryPath();
+  tracer.Open(path, std::chrono::milliseconds(1));
+  const double open = measure();
+  tracer.Close();
+  unlink(path.c_str());
+
+  std::cout << "[ BENCHMARK] SONIA_TRACE_SCOPE: " << open
+            << " ns per span, " << closed << " ns when closed, "
+            << tracer.DroppedCount() << " dropped" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}